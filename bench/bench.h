@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Простая среда микробенчмарков: прогрев, повторения, медиана и перцентили, барьеры оптимизации
+// и вывод в CSV или JSON для отслеживания регрессий
+
+namespace bench {
+
+// Не даёт компилятору выбросить вычисление value
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Заставляет компилятор считать, что вся память могла быть прочитана и изменена
+inline void ClobberMemory() {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+using Clock = std::chrono::steady_clock;
+
+inline double ElapsedNs(Clock::time_point start, Clock::time_point finish) {
+    return std::chrono::duration<double, std::nano>(finish - start).count();
+}
+
+struct Options {
+    std::string format = "csv";    // csv или json
+    std::string filter;            // подстрока полного имени случая
+    size_t max_size = 1'000'000;   // наибольший размер контейнера
+    size_t repetitions = 15;
+    size_t warmup = 2;
+    bool list = false;             // только перечислить случаи
+};
+
+// Описание случая: группа, операция, контейнер, тип элемента и размер
+struct Case {
+    std::string suite;
+    std::string name;
+    std::string container;
+    std::string type;
+    size_t size = 0;
+
+    std::string FullName() const {
+        return suite + "/" + name + "/" + container + "/" + type + "/" + std::to_string(size);
+    }
+};
+
+// Статистика выборки, значения в наносекундах
+struct Stats {
+    size_t samples = 0;
+    double min = 0;
+    double median = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+    double mean = 0;
+};
+
+inline double Percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+inline Stats ComputeStats(std::vector<double> samples) {
+    Stats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    stats.samples = samples.size();
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.median = Percentile(samples, 0.5);
+    stats.p90 = Percentile(samples, 0.9);
+    stats.p99 = Percentile(samples, 0.99);
+    stats.p999 = Percentile(samples, 0.999);
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    stats.mean = sum / static_cast<double>(samples.size());
+    return stats;
+}
+
+struct Result {
+    Case bench_case;
+    Stats stats;
+    // Количество элементов, обработанных за один замер, для пересчёта во время на элемент
+    size_t items = 0;
+    // Дополнительные метрики случая: пропускная способность, пиковая память и т. п.
+    std::map<std::string, double> metrics;
+};
+
+class Runner {
+public:
+    explicit Runner(Options options, std::ostream& out)
+        : options_(std::move(options))
+        , out_(out)
+    {
+    }
+
+    const Options& GetOptions() const noexcept {
+        return options_;
+    }
+
+    // Размеры 10, 100, ..., не больше max_size и limit
+    std::vector<size_t> Sizes(size_t limit = SIZE_MAX) const {
+        std::vector<size_t> sizes;
+        for (size_t size = 10; size <= std::min(options_.max_size, limit); size *= 10) {
+            sizes.push_back(size);
+        }
+        return sizes;
+    }
+
+    // Выполнять ли случай: совпадает с фильтром и не включён режим перечисления
+    bool Enabled(const Case& bench_case) {
+        if (!options_.filter.empty() && bench_case.FullName().find(options_.filter) == std::string::npos) {
+            return false;
+        }
+        if (options_.list) {
+            out_ << bench_case.FullName() << '\n';
+            return false;
+        }
+        return true;
+    }
+
+    // Замеряет body целиком. Короткие тела повторяются в цикле, чтобы замер длился не меньше MIN_SAMPLE_NS
+    template <typename Body>
+    void Run(const Case& bench_case, size_t items, Body body, std::map<std::string, double> metrics = {}) {
+        if (!Enabled(bench_case)) {
+            return;
+        }
+        size_t batch = 1;
+        while (true) {
+            const Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < batch; ++i) {
+                body();
+            }
+            if (ElapsedNs(start, Clock::now()) >= MIN_SAMPLE_NS || batch >= MAX_BATCH) {
+                break;
+            }
+            batch *= 2;
+        }
+        std::vector<double> samples;
+        for (size_t rep = 0; rep < options_.warmup + options_.repetitions; ++rep) {
+            const Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < batch; ++i) {
+                body();
+                ClobberMemory();
+            }
+            const double elapsed = ElapsedNs(start, Clock::now()) / static_cast<double>(batch);
+            if (rep >= options_.warmup) {
+                samples.push_back(elapsed);
+            }
+        }
+        Report(MakeResult(bench_case, std::move(samples), items, std::move(metrics)));
+    }
+
+    // Замеряет body(fixture) для заготовок, созданных setup() вне замера; заготовки разрушаются тоже вне замера.
+    // Для маленьких размеров случая в одном замере обрабатывается несколько заготовок
+    template <typename Setup, typename Body>
+    void RunWithSetup(const Case& bench_case, size_t items, Setup setup, Body body,
+                      std::map<std::string, double> metrics = {}) {
+        if (!Enabled(bench_case)) {
+            return;
+        }
+        const size_t batch = std::max<size_t>(1, MIN_BATCH_ITEMS / std::max<size_t>(bench_case.size, 1));
+        std::vector<double> samples;
+        for (size_t rep = 0; rep < options_.warmup + options_.repetitions; ++rep) {
+            std::vector<decltype(setup())> fixtures;
+            fixtures.reserve(batch);
+            for (size_t i = 0; i < batch; ++i) {
+                fixtures.push_back(setup());
+            }
+            const Clock::time_point start = Clock::now();
+            for (auto& fixture : fixtures) {
+                body(fixture);
+                ClobberMemory();
+            }
+            const double elapsed = ElapsedNs(start, Clock::now()) / static_cast<double>(batch);
+            if (rep >= options_.warmup) {
+                samples.push_back(elapsed);
+            }
+        }
+        Report(MakeResult(bench_case, std::move(samples), items, std::move(metrics)));
+    }
+
+    // Выводит готовую выборку, например задержки отдельных операций
+    void ReportSamples(const Case& bench_case, std::vector<double> samples, size_t items = 1,
+                       std::map<std::string, double> metrics = {}) {
+        Report(MakeResult(bench_case, std::move(samples), items, std::move(metrics)));
+    }
+
+    void Report(const Result& result) {
+        if (options_.format == "json") {
+            ReportJson(result);
+        }
+        else {
+            ReportCsv(result);
+        }
+    }
+
+    // Завершает вывод (закрывает массив JSON)
+    void Finish() {
+        if (options_.format == "json" && !options_.list) {
+            out_ << (reported_ == 0 ? "[" : "") << "\n]\n";
+        }
+    }
+
+private:
+    // Если среди метрик есть bytes (байт за один замер), добавляется пропускная способность gb_per_s по медиане
+    static Result MakeResult(const Case& bench_case, std::vector<double> samples, size_t items,
+                             std::map<std::string, double> metrics) {
+        Result result{ bench_case, ComputeStats(std::move(samples)), items, std::move(metrics) };
+        const auto bytes = result.metrics.find("bytes");
+        if (bytes != result.metrics.end() && result.stats.median > 0) {
+            result.metrics["gb_per_s"] = bytes->second / result.stats.median;
+        }
+        return result;
+    }
+
+    static constexpr double MIN_SAMPLE_NS = 100'000;
+    static constexpr size_t MAX_BATCH = 1 << 20;
+    static constexpr size_t MIN_BATCH_ITEMS = 100'000;
+
+    static std::string FormatMetrics(const Result& result, const char* separator, const char* quote) {
+        std::string text;
+        for (const auto& [name, value] : result.metrics) {
+            if (!text.empty()) {
+                text += separator;
+            }
+            text += quote + name + quote + (quote[0] != '\0' ? ": " : "=") + std::to_string(value);
+        }
+        return text;
+    }
+
+    void ReportCsv(const Result& result) {
+        if (reported_++ == 0) {
+            out_ << "suite,name,container,type,size,samples,min_ns,median_ns,p90_ns,p99_ns,p999_ns,max_ns,mean_ns,"
+                    "median_ns_per_item,metrics\n";
+        }
+        const Case& c = result.bench_case;
+        const Stats& s = result.stats;
+        out_ << c.suite << ',' << c.name << ',' << c.container << ',' << c.type << ',' << c.size << ','
+             << s.samples << ',' << s.min << ',' << s.median << ',' << s.p90 << ',' << s.p99 << ',' << s.p999 << ','
+             << s.max << ',' << s.mean << ',' << s.median / static_cast<double>(std::max<size_t>(result.items, 1)) << ','
+             << FormatMetrics(result, ";", "") << '\n';
+    }
+
+    void ReportJson(const Result& result) {
+        const Case& c = result.bench_case;
+        const Stats& s = result.stats;
+        out_ << (reported_++ == 0 ? "[\n" : ",\n")
+             << "  {\"suite\": \"" << c.suite << "\", \"name\": \"" << c.name << "\", \"container\": \"" << c.container
+             << "\", \"type\": \"" << c.type << "\", \"size\": " << c.size << ", \"samples\": " << s.samples
+             << ", \"min_ns\": " << s.min << ", \"median_ns\": " << s.median << ", \"p90_ns\": " << s.p90
+             << ", \"p99_ns\": " << s.p99 << ", \"p999_ns\": " << s.p999 << ", \"max_ns\": " << s.max
+             << ", \"mean_ns\": " << s.mean << ", \"median_ns_per_item\": "
+             << s.median / static_cast<double>(std::max<size_t>(result.items, 1))
+             << ", \"metrics\": {" << FormatMetrics(result, ", ", "\"") << "}}";
+    }
+
+    Options options_;
+    std::ostream& out_;
+    size_t reported_ = 0;
+};
+
+// Группы случаев, по одной функции на файл
+void RunContainerBenchmarks(Runner& runner);
+void RunFeatureBenchmarks(Runner& runner);
+
+}  // namespace bench
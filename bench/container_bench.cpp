@@ -0,0 +1,313 @@
+#include "bench.h"
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Сравнение Vector и std::vector на основных операциях для типов разной природы
+
+namespace bench {
+
+namespace {
+
+// ---------- Container adapters ----------------------------------------------
+
+template <typename T>
+const char* ContainerName(const std::vector<T>& /*c*/) {
+    return "std::vector";
+}
+
+template <typename T>
+const char* ContainerName(const Vector<T>& /*c*/) {
+    return "Vector";
+}
+
+template <typename T, typename... Args>
+void EmplaceBack(std::vector<T>& c, Args&&... args) {
+    c.emplace_back(std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+void EmplaceBack(Vector<T>& c, Args&&... args) {
+    c.EmplaceBack(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void PushBack(std::vector<T>& c, T&& value) {
+    c.push_back(std::move(value));
+}
+
+template <typename T>
+void PushBack(Vector<T>& c, T&& value) {
+    c.PushBack(std::move(value));
+}
+
+template <typename T>
+void Reserve(std::vector<T>& c, size_t n) {
+    c.reserve(n);
+}
+
+template <typename T>
+void Reserve(Vector<T>& c, size_t n) {
+    c.Reserve(n);
+}
+
+template <typename T>
+void Resize(std::vector<T>& c, size_t n) {
+    c.resize(n);
+}
+
+template <typename T>
+void Resize(Vector<T>& c, size_t n) {
+    c.Resize(n);
+}
+
+template <typename T>
+void InsertAt(std::vector<T>& c, size_t index, T&& value) {
+    c.insert(c.begin() + index, std::move(value));
+}
+
+template <typename T>
+void InsertAt(Vector<T>& c, size_t index, T&& value) {
+    c.Insert(c.cbegin() + index, std::move(value));
+}
+
+template <typename T>
+void EraseAt(std::vector<T>& c, size_t index) {
+    c.erase(c.begin() + index);
+}
+
+template <typename T>
+void EraseAt(Vector<T>& c, size_t index) {
+    c.Erase(c.cbegin() + index);
+}
+
+template <typename T>
+const T* DataOf(const std::vector<T>& c) {
+    return c.data();
+}
+
+template <typename T>
+const T* DataOf(const Vector<T>& c) {
+    return c.Data();
+}
+
+// ---------- Element types ---------------------------------------------------
+
+struct Pod64 {
+    uint64_t words[8];
+};
+
+using MoveOnly = std::unique_ptr<uint64_t>;
+
+// Длина строк больше буфера малых строк, чтобы копирование выделяло память
+constexpr size_t STRING_LENGTH = 32;
+
+template <typename T>
+struct Element;
+
+template <>
+struct Element<uint64_t> {
+    static constexpr const char* NAME = "uint64";
+
+    static uint64_t Make(size_t i) {
+        return i;
+    }
+
+    template <typename Container>
+    static void Emplace(Container& c, size_t i) {
+        EmplaceBack(c, i);
+    }
+
+    static uint64_t Checksum(uint64_t value) {
+        return value;
+    }
+};
+
+template <>
+struct Element<Pod64> {
+    static constexpr const char* NAME = "pod64";
+
+    static Pod64 Make(size_t i) {
+        return Pod64{ { i, i, i, i, i, i, i, i } };
+    }
+
+    template <typename Container>
+    static void Emplace(Container& c, size_t i) {
+        EmplaceBack(c, Make(i));
+    }
+
+    static uint64_t Checksum(const Pod64& value) {
+        return value.words[0];
+    }
+};
+
+template <>
+struct Element<std::string> {
+    static constexpr const char* NAME = "string";
+
+    static std::string Make(size_t i) {
+        return std::string(STRING_LENGTH, static_cast<char>('a' + i % 26));
+    }
+
+    template <typename Container>
+    static void Emplace(Container& c, size_t i) {
+        EmplaceBack(c, STRING_LENGTH, static_cast<char>('a' + i % 26));
+    }
+
+    static uint64_t Checksum(const std::string& value) {
+        return value.size();
+    }
+};
+
+template <>
+struct Element<MoveOnly> {
+    static constexpr const char* NAME = "move_only";
+
+    static MoveOnly Make(size_t i) {
+        return std::make_unique<uint64_t>(i);
+    }
+
+    template <typename Container>
+    static void Emplace(Container& c, size_t i) {
+        EmplaceBack(c, new uint64_t(i));
+    }
+
+    static uint64_t Checksum(const MoveOnly& value) {
+        return *value;
+    }
+};
+
+template <typename Container, typename T>
+Container MakeFilled(size_t n) {
+    Container c;
+    Reserve(c, n);
+    for (size_t i = 0; i < n; ++i) {
+        PushBack(c, Element<T>::Make(i));
+    }
+    return c;
+}
+
+// Позиция вставки и удаления: начало, середина или конец
+struct Position {
+    const char* name;
+    size_t numerator;
+};
+
+constexpr Position POSITIONS[] = { { "front", 0 }, { "middle", 1 }, { "back", 2 } };
+
+size_t IndexAt(const Position& position, size_t size) {
+    return size * position.numerator / 2;
+}
+
+// ---------- Benchmarks ------------------------------------------------------
+
+template <typename Container, typename T>
+void RunContainerCases(Runner& runner) {
+    const char* container = ContainerName(Container());
+    const char* type = Element<T>::NAME;
+
+    for (size_t n : runner.Sizes()) {
+        const auto make_case = [&](const std::string& name) {
+            return Case{ "container", name, container, type, n };
+        };
+
+        runner.Run(make_case("push_back"), n, [n] {
+            Container c;
+            for (size_t i = 0; i < n; ++i) {
+                PushBack(c, Element<T>::Make(i));
+            }
+            DoNotOptimize(DataOf(c));
+        });
+
+        runner.Run(make_case("emplace_back"), n, [n] {
+            Container c;
+            for (size_t i = 0; i < n; ++i) {
+                Element<T>::Emplace(c, i);
+            }
+            DoNotOptimize(DataOf(c));
+        });
+
+        runner.Run(make_case("reserve_push_back"), n, [n] {
+            Container c;
+            Reserve(c, n);
+            for (size_t i = 0; i < n; ++i) {
+                PushBack(c, Element<T>::Make(i));
+            }
+            DoNotOptimize(DataOf(c));
+        });
+
+        runner.Run(make_case("resize"), n, [n] {
+            Container c;
+            Resize(c, n);
+            DoNotOptimize(DataOf(c));
+        });
+
+        for (const Position& position : POSITIONS) {
+            const size_t index = IndexAt(position, n);
+            runner.RunWithSetup(make_case(std::string("insert_") + position.name), 1,
+                [n] { return MakeFilled<Container, T>(n); },
+                [index](Container& c) {
+                    InsertAt(c, index, Element<T>::Make(index));
+                    DoNotOptimize(DataOf(c));
+                });
+
+            const size_t erase_index = std::min(index, n - 1);
+            runner.RunWithSetup(make_case(std::string("erase_") + position.name), 1,
+                [n] { return MakeFilled<Container, T>(n); },
+                [erase_index](Container& c) {
+                    EraseAt(c, erase_index);
+                    DoNotOptimize(DataOf(c));
+                });
+        }
+
+        if constexpr (std::is_copy_constructible_v<T>) {
+            const Container source = MakeFilled<Container, T>(n);
+            runner.Run(make_case("copy"), n, [&source] {
+                Container copy(source);
+                DoNotOptimize(DataOf(copy));
+            });
+        }
+
+        runner.RunWithSetup(make_case("move"), 1,
+            [n] { return MakeFilled<Container, T>(n); },
+            [](Container& c) {
+                Container moved(std::move(c));
+                DoNotOptimize(DataOf(moved));
+                // Разрушение перемещённого буфера не входит в замер
+                c = std::move(moved);
+            });
+
+        const Container source = MakeFilled<Container, T>(n);
+        runner.Run(make_case("iterate"), n, [&source] {
+            uint64_t sum = 0;
+            for (const T& value : source) {
+                sum += Element<T>::Checksum(value);
+            }
+            DoNotOptimize(sum);
+        });
+    }
+}
+
+template <typename T>
+void RunTypeCases(Runner& runner) {
+    RunContainerCases<std::vector<T>, T>(runner);
+    RunContainerCases<Vector<T>, T>(runner);
+}
+
+}  // namespace
+
+void RunContainerBenchmarks(Runner& runner) {
+    RunTypeCases<uint64_t>(runner);
+    RunTypeCases<Pod64>(runner);
+    RunTypeCases<std::string>(runner);
+    RunTypeCases<MoveOnly>(runner);
+}
+
+}  // namespace bench
@@ -0,0 +1,727 @@
+#include "bench.h"
+
+#include "allocators.h"
+#include "concurrent_vector.h"
+#include "flat_map.h"
+#include "gap_vector.h"
+#include "growth_policy.h"
+#include "numeric.h"
+#include "parallel.h"
+#include "segmented_vector.h"
+#include "small_vector.h"
+#include "static_vector.h"
+#include "streaming_copy.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fstream>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define VECTOR_BENCH_FORK 1
+#else
+#define VECTOR_BENCH_FORK 0
+#endif
+
+// Измерения возможностей библиотеки: рост через realloc/mremap, политики роста, инициализация по умолчанию,
+// большие страницы, числовые ядра, параллельные и многопоточные операции, задержки отдельных добавлений
+
+namespace bench {
+
+namespace {
+
+// ---------- Helpers ---------------------------------------------------------
+
+// Генератор псевдослучайных индексов (xorshift64)
+class Random {
+public:
+    explicit Random(uint64_t seed) noexcept
+        : state_(seed)
+    {
+    }
+
+    uint64_t Next() noexcept {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        return state_;
+    }
+
+private:
+    uint64_t state_;
+};
+
+std::vector<size_t> SizesFrom(const Runner& runner, size_t min_size) {
+    std::vector<size_t> sizes = runner.Sizes();
+    sizes.erase(std::remove_if(sizes.begin(), sizes.end(), [min_size](size_t size) {
+        return size < min_size;
+    }), sizes.end());
+    return sizes;
+}
+
+double Median(std::vector<double> values) {
+    return ComputeStats(std::move(values)).median;
+}
+
+#if VECTOR_BENCH_FORK
+// Пиковый RSS процесса в КиБ. В Linux пик можно сбросить до текущего RSS записью "5" в /proc/self/clear_refs
+// и прочитать как VmHWM; иначе используется ru_maxrss, который только растёт
+double PeakRssKb() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stod(line.substr(6));
+        }
+    }
+#endif
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss);
+}
+
+void ResetPeakRss() {
+#if defined(__GLIBC__)
+    // Свободные страницы кучи, унаследованные от родителя, иначе переиспользуются без роста RSS
+    malloc_trim(0);
+#endif
+#if defined(__linux__)
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+#endif
+
+struct IsolatedSample {
+    double elapsed_ns = 0;
+    double peak_rss_kb = 0;  // прирост пикового RSS за время измерения
+};
+
+// Выполняет body в дочернем процессе, чтобы пиковый RSS относился только к этому измерению.
+// Без fork пиковая память не измеряется
+template <typename Body>
+IsolatedSample RunIsolated(Body body) {
+#if VECTOR_BENCH_FORK
+    int fds[2];
+    if (pipe(fds) == 0) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            ResetPeakRss();
+            const double before = PeakRssKb();
+            const Clock::time_point start = Clock::now();
+            body();
+            IsolatedSample sample;
+            sample.elapsed_ns = ElapsedNs(start, Clock::now());
+            sample.peak_rss_kb = PeakRssKb() - before;
+            const bool written = write(fds[1], &sample, sizeof(sample)) == static_cast<ssize_t>(sizeof(sample));
+            _exit(written ? 0 : 1);
+        }
+        close(fds[1]);
+        IsolatedSample sample;
+        const bool received = pid > 0 && read(fds[0], &sample, sizeof(sample)) == static_cast<ssize_t>(sizeof(sample));
+        close(fds[0]);
+        if (pid > 0) {
+            waitpid(pid, nullptr, 0);
+        }
+        if (received) {
+            return sample;
+        }
+    }
+#endif
+    IsolatedSample sample;
+    const Clock::time_point start = Clock::now();
+    body();
+    sample.elapsed_ns = ElapsedNs(start, Clock::now());
+    return sample;
+}
+
+// ---------- Growth: realloc/mremap ------------------------------------------
+
+template <typename Container>
+void RunGrowthCase(Runner& runner, const char* container, size_t n) {
+    const Case bench_case{ "growth", "push_back", container, "uint64", n };
+    if (!runner.Enabled(bench_case)) {
+        return;
+    }
+    const Options& options = runner.GetOptions();
+    std::vector<double> samples;
+    std::vector<double> peaks;
+    for (size_t rep = 0; rep < options.warmup + options.repetitions; ++rep) {
+        const IsolatedSample sample = RunIsolated([n] {
+            Container c;
+            for (size_t i = 0; i < n; ++i) {
+                c.PushBack(i);
+            }
+            DoNotOptimize(c.Data());
+        });
+        if (rep >= options.warmup) {
+            samples.push_back(sample.elapsed_ns);
+            peaks.push_back(sample.peak_rss_kb);
+        }
+    }
+    runner.ReportSamples(bench_case, std::move(samples), n, { { "peak_rss_kb", Median(std::move(peaks)) } });
+}
+
+void RunGrowthBenchmarks(Runner& runner) {
+    for (size_t n : runner.Sizes()) {
+        RunGrowthCase<Vector<uint64_t>>(runner, "Vector", n);
+        RunGrowthCase<Vector<uint64_t, ReallocAllocator<uint64_t>>>(runner, "Vector<ReallocAllocator>", n);
+    }
+}
+
+// ---------- Growth policies -------------------------------------------------
+
+template <typename Policy>
+void RunPolicyCase(Runner& runner, const char* policy, size_t n) {
+    using Container = Vector<uint64_t, std::allocator<uint64_t>, Policy>;
+    Container probe;
+    for (size_t i = 0; i < n; ++i) {
+        probe.PushBack(i);
+    }
+    const double overhead = static_cast<double>(probe.Capacity() - n) / static_cast<double>(n);
+    runner.Run(Case{ "growth_policy", "push_back", policy, "uint64", n }, n, [n] {
+        Container c;
+        for (size_t i = 0; i < n; ++i) {
+            c.PushBack(i);
+        }
+        DoNotOptimize(c.Data());
+    }, { { "capacity_overhead", overhead } });
+}
+
+void RunGrowthPolicyBenchmarks(Runner& runner) {
+    for (size_t n : runner.Sizes()) {
+        RunPolicyCase<DoublingGrowth>(runner, "DoublingGrowth", n);
+        RunPolicyCase<OneAndHalfGrowth>(runner, "OneAndHalfGrowth", n);
+        RunPolicyCase<CacheLineGrowth<>>(runner, "CacheLineGrowth", n);
+        RunPolicyCase<SizeClassGrowth<>>(runner, "SizeClassGrowth", n);
+        RunPolicyCase<IncrementalGrowth<>>(runner, "IncrementalGrowth", n);
+    }
+}
+
+// ---------- Default initialization ------------------------------------------
+
+void RunDefaultInitBenchmarks(Runner& runner) {
+    for (size_t n : SizesFrom(runner, 1000)) {
+        const auto make_case = [n](const char* name) {
+            return Case{ "default_init", name, "Vector", "uint64", n };
+        };
+        const std::map<std::string, double> metrics = { { "bytes", static_cast<double>(n * sizeof(uint64_t)) } };
+
+        runner.Run(make_case("resize_fill"), n, [n] {
+            Vector<uint64_t> v;
+            v.Resize(n);
+            std::fill_n(v.Data(), n, uint64_t{ 1 });
+            DoNotOptimize(v.Data());
+        }, metrics);
+
+        runner.Run(make_case("resize_default_init_fill"), n, [n] {
+            Vector<uint64_t> v;
+            v.ResizeDefaultInit(n);
+            std::fill_n(v.Data(), n, uint64_t{ 1 });
+            DoNotOptimize(v.Data());
+        }, metrics);
+
+        runner.Run(make_case("resize_for_overwrite_fill"), n, [n] {
+            Vector<uint64_t> v;
+            std::fill_n(v.ResizeForOverwrite(n), n, uint64_t{ 1 });
+            DoNotOptimize(v.Data());
+        }, metrics);
+    }
+}
+
+// ---------- Huge pages ------------------------------------------------------
+
+constexpr size_t RANDOM_ACCESSES = 1 << 16;
+
+template <typename Container>
+void RunRandomAccessCase(Runner& runner, const char* container, size_t n) {
+    if (!runner.Enabled(Case{ "huge_pages", "random_access", container, "uint64", n })) {
+        return;
+    }
+    Container v;
+    v.Resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = i;
+    }
+    runner.Run(Case{ "huge_pages", "random_access", container, "uint64", n }, RANDOM_ACCESSES, [&v, n] {
+        Random random(n);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < RANDOM_ACCESSES; ++i) {
+            sum += v[random.Next() % n];
+        }
+        DoNotOptimize(sum);
+    });
+}
+
+void RunHugePageBenchmarks(Runner& runner) {
+    for (size_t n : SizesFrom(runner, 10000)) {
+        RunRandomAccessCase<Vector<uint64_t>>(runner, "Vector", n);
+        RunRandomAccessCase<Vector<uint64_t, HugePageAllocator<uint64_t>>>(runner, "Vector<HugePageAllocator>", n);
+    }
+}
+
+// ---------- Numeric kernels -------------------------------------------------
+
+const char* IsaName(numeric::Isa isa) {
+    switch (isa) {
+    case numeric::Isa::SSE42:
+        return "sse42";
+    case numeric::Isa::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+template <typename T>
+void RunNumericCases(Runner& runner, const char* type, numeric::Isa isa, size_t n) {
+    const auto make_case = [&](const char* name) {
+        return Case{ "numeric", name, IsaName(isa), type, n };
+    };
+    const double bytes = static_cast<double>(n * sizeof(T));
+    Vector<T> x;
+    Vector<T> y;
+    x.Resize(n);
+    y.Resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<T>(i % 100) / 100;
+        y[i] = static_cast<T>(i % 7);
+    }
+
+    runner.Run(make_case("sum"), n, [&x] {
+        DoNotOptimize(numeric::Sum(x));
+    }, { { "bytes", bytes } });
+
+    runner.Run(make_case("dot"), n, [&x, &y] {
+        DoNotOptimize(numeric::Dot(x, y));
+    }, { { "bytes", 2 * bytes } });
+
+    runner.Run(make_case("max"), n, [&x] {
+        DoNotOptimize(numeric::Max(x));
+    }, { { "bytes", bytes } });
+
+    // Чтение x, чтение и запись y
+    runner.Run(make_case("axpy"), n, [&x, &y] {
+        numeric::Axpy(T{ 0 }, x, y);
+        DoNotOptimize(y.Data());
+    }, { { "bytes", 3 * bytes } });
+}
+
+void RunNumericBenchmarks(Runner& runner) {
+    const numeric::Isa detected = numeric::DetectIsa();
+    for (numeric::Isa isa : { numeric::Isa::SCALAR, numeric::Isa::SSE42, numeric::Isa::AVX2 }) {
+        if (isa > detected) {
+            break;
+        }
+        numeric::ForceIsa(isa);
+        for (size_t n : SizesFrom(runner, 1000)) {
+            RunNumericCases<float>(runner, "float", isa, n);
+            RunNumericCases<double>(runner, "double", isa, n);
+        }
+    }
+    numeric::ForceIsa(detected);
+}
+
+// ---------- Parallel construction -------------------------------------------
+
+void RunParallelBenchmarks(Runner& runner) {
+    for (size_t n : SizesFrom(runner, 10000)) {
+        const auto make_case = [n](const char* name, const char* container) {
+            return Case{ "parallel", name, container, "double", n };
+        };
+        const std::map<std::string, double> metrics = { { "bytes", static_cast<double>(n * sizeof(double)) } };
+
+        runner.Run(make_case("resize", "Vector"), n, [n] {
+            Vector<double> v;
+            v.Resize(n);
+            DoNotOptimize(v.Data());
+        }, metrics);
+
+        runner.Run(make_case("resize", "ParallelResize"), n, [n] {
+            Vector<double> v;
+            ParallelResize(v, n);
+            DoNotOptimize(v.Data());
+        }, metrics);
+
+        Vector<double> source;
+        source.Resize(n);
+        runner.Run(make_case("copy", "Vector"), n, [&source] {
+            Vector<double> copy(source);
+            DoNotOptimize(copy.Data());
+        }, metrics);
+
+        runner.Run(make_case("copy", "ParallelCopy"), n, [&source] {
+            Vector<double> copy = ParallelCopy(source);
+            DoNotOptimize(copy.Data());
+        }, metrics);
+    }
+}
+
+// ---------- Streaming copy --------------------------------------------------
+
+// Рабочий набор читателя помещается в кэш последнего уровня, пока его не вытесняет копирование
+constexpr size_t READER_WORKING_SET = 1024 * 1024;
+
+const char* HintName(StreamingHint hint) {
+    return hint == StreamingHint::ALWAYS ? "CopyFrom(ALWAYS)" : "CopyFrom(NEVER)";
+}
+
+// Время прохода читателя по своему рабочему набору, пока основной поток copies раз выполняет work().
+// Рост времени прохода по сравнению с простоем показывает, сколько данных читателя вытеснила копия
+template <typename Work>
+void RunReaderCase(Runner& runner, const Case& bench_case, size_t copies, Work work) {
+    if (!runner.Enabled(bench_case)) {
+        return;
+    }
+    Vector<uint64_t> working_set(READER_WORKING_SET / sizeof(uint64_t));
+    std::atomic<bool> stop{ false };
+    std::vector<double> samples;
+    std::thread reader([&working_set, &stop, &samples] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            const Clock::time_point start = Clock::now();
+            uint64_t sum = 0;
+            for (uint64_t value : working_set) {
+                sum += value;
+            }
+            DoNotOptimize(sum);
+            samples.push_back(ElapsedNs(start, Clock::now()));
+        }
+    });
+    for (size_t i = 0; i < copies; ++i) {
+        work();
+    }
+    stop.store(true, std::memory_order_relaxed);
+    reader.join();
+    runner.ReportSamples(bench_case, std::move(samples), working_set.Size(),
+        { { "bytes", static_cast<double>(READER_WORKING_SET) } });
+}
+
+void RunStreamingBenchmarks(Runner& runner) {
+    const std::vector<size_t> sizes = SizesFrom(runner, 100000);
+    for (size_t n : sizes) {
+        Vector<double> source(n);
+        Vector<double> destination(n);
+        for (StreamingHint hint : { StreamingHint::NEVER, StreamingHint::ALWAYS }) {
+            runner.Run(Case{ "streaming_copy", "copy", HintName(hint), "double", n }, n, [&source, &destination, hint] {
+                destination.CopyFrom(source, hint);
+                DoNotOptimize(destination.Data());
+            }, { { "bytes", static_cast<double>(n * sizeof(double)) } });
+        }
+    }
+    if (sizes.empty()) {
+        return;
+    }
+
+    const size_t n = sizes.back();
+    const Options& options = runner.GetOptions();
+    const size_t copies = std::max<size_t>(10, options.warmup + options.repetitions);
+    Vector<double> source(n);
+    Vector<double> destination(n);
+    RunReaderCase(runner, Case{ "streaming_copy", "reader_pass", "idle", "uint64", n }, copies, [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    for (StreamingHint hint : { StreamingHint::NEVER, StreamingHint::ALWAYS }) {
+        RunReaderCase(runner, Case{ "streaming_copy", "reader_pass", HintName(hint), "uint64", n }, copies,
+            [&source, &destination, hint] {
+                destination.CopyFrom(source, hint);
+                DoNotOptimize(destination.Data());
+            });
+    }
+}
+
+// ---------- Flat map --------------------------------------------------------
+
+constexpr size_t MAP_LOOKUPS = 1 << 14;
+
+// Поэлементная вставка в FlatMap сдвигает O(n) записей, поэтому измеряется только на небольших таблицах
+constexpr size_t MAX_INSERT_LOOP_SIZE = 10000;
+
+using KeyValues = std::vector<std::pair<uint64_t, uint64_t>>;
+
+KeyValues RandomKeyValues(size_t n, uint64_t seed) {
+    Random random(seed);
+    KeyValues items;
+    items.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        items.emplace_back(random.Next(), i);
+    }
+    return items;
+}
+
+// Запросы: половина — существующие ключи, половина — отсутствующие
+std::vector<uint64_t> LookupKeys(const KeyValues& items) {
+    Random random(items.size() + 1);
+    std::vector<uint64_t> keys;
+    keys.reserve(MAP_LOOKUPS);
+    for (size_t i = 0; i < MAP_LOOKUPS; ++i) {
+        keys.push_back(i % 2 == 0 ? items[random.Next() % items.size()].first : random.Next());
+    }
+    return keys;
+}
+
+template <typename Map>
+bool MapContains(const Map& map, uint64_t key) {
+    if constexpr (std::is_same_v<Map, std::map<uint64_t, uint64_t>> || std::is_same_v<Map, std::unordered_map<uint64_t, uint64_t>>) {
+        return map.find(key) != map.end();
+    }
+    else {
+        return map.Contains(key);
+    }
+}
+
+template <typename Map>
+void RunMapLookupCase(Runner& runner, const char* container, const KeyValues& items,
+                      const std::vector<uint64_t>& keys) {
+    const Case bench_case{ "flat_map", "lookup", container, "uint64", items.size() };
+    if (!runner.Enabled(bench_case)) {
+        return;
+    }
+    const Map map(items.begin(), items.end());
+    runner.Run(bench_case, keys.size(), [&map, &keys] {
+        size_t found = 0;
+        for (uint64_t key : keys) {
+            found += MapContains(map, key) ? 1 : 0;
+        }
+        DoNotOptimize(found);
+    });
+}
+
+void RunFlatMapBenchmarks(Runner& runner) {
+    using Flat = FlatMap<uint64_t, uint64_t>;
+    for (size_t n : runner.Sizes()) {
+        const KeyValues items = RandomKeyValues(n, n);
+        const auto make_case = [n](const char* name, const char* container) {
+            return Case{ "flat_map", name, container, "uint64", n };
+        };
+
+        runner.Run(make_case("build", "FlatMap"), n, [&items] {
+            Flat map(items.begin(), items.end());
+            DoNotOptimize(map.Keys().Data());
+        });
+        runner.Run(make_case("build", "std::map"), n, [&items] {
+            std::map<uint64_t, uint64_t> map(items.begin(), items.end());
+            DoNotOptimize(map.size());
+        });
+        runner.Run(make_case("build", "std::unordered_map"), n, [&items] {
+            std::unordered_map<uint64_t, uint64_t> map(items.begin(), items.end());
+            DoNotOptimize(map.size());
+        });
+
+        const std::vector<uint64_t> keys = LookupKeys(items);
+        RunMapLookupCase<Flat>(runner, "FlatMap", items, keys);
+        RunMapLookupCase<FlatMap<uint64_t, uint64_t, std::less<uint64_t>, BranchlessLookup>>(runner,
+            "FlatMap<BranchlessLookup>", items, keys);
+        RunMapLookupCase<FlatMap<uint64_t, uint64_t, std::less<uint64_t>, EytzingerLookup>>(runner,
+            "FlatMap<EytzingerLookup>", items, keys);
+        RunMapLookupCase<std::map<uint64_t, uint64_t>>(runner, "std::map", items, keys);
+        RunMapLookupCase<std::unordered_map<uint64_t, uint64_t>>(runner, "std::unordered_map", items, keys);
+
+        // Добавление пакета из n / 10 новых записей
+        const KeyValues batch = RandomKeyValues(std::max<size_t>(1, n / 10), n + 2);
+        runner.RunWithSetup(make_case("insert_batch", "FlatMap::InsertMany"), batch.size(),
+            [&items] { return Flat(items.begin(), items.end()); },
+            [&batch](Flat& map) {
+                DoNotOptimize(map.InsertMany(batch.begin(), batch.end()));
+            });
+        if (n <= MAX_INSERT_LOOP_SIZE) {
+            runner.RunWithSetup(make_case("insert_batch", "FlatMap::Insert"), batch.size(),
+                [&items] { return Flat(items.begin(), items.end()); },
+                [&batch](Flat& map) {
+                    for (const auto& [key, value] : batch) {
+                        map.Insert(key, value);
+                    }
+                    DoNotOptimize(map.Keys().Data());
+                });
+        }
+        runner.RunWithSetup(make_case("insert_batch", "std::map"), batch.size(),
+            [&items] { return std::map<uint64_t, uint64_t>(items.begin(), items.end()); },
+            [&batch](std::map<uint64_t, uint64_t>& map) {
+                map.insert(batch.begin(), batch.end());
+                DoNotOptimize(map.size());
+            });
+    }
+}
+
+// ---------- Gap vector ------------------------------------------------------
+
+// n вставок подряд у курсора, начиная с середины контейнера из n элементов (набор текста в редакторе)
+template <typename Container>
+void RunCursorInsertCase(Runner& runner, const char* container, size_t n) {
+    runner.RunWithSetup(Case{ "gap_vector", "cursor_insert", container, "uint64", n }, n,
+        [n] {
+            Container values;
+            for (size_t i = 0; i < n; ++i) {
+                values.PushBack(i);
+            }
+            return values;
+        },
+        [n](Container& values) {
+            auto cursor = values.cbegin() + n / 2;
+            for (size_t i = 0; i < n; ++i) {
+                cursor = values.Insert(cursor, i) + 1;
+            }
+            DoNotOptimize(values[n / 2]);
+        });
+}
+
+void RunGapVectorBenchmarks(Runner& runner) {
+    for (size_t n : runner.Sizes()) {
+        RunCursorInsertCase<GapVector<uint64_t>>(runner, "GapVector", n);
+        // Вставка в Vector сдвигает хвост: n вставок стоят O(n^2)
+        if (n <= MAX_INSERT_LOOP_SIZE) {
+            RunCursorInsertCase<Vector<uint64_t>>(runner, "Vector", n);
+        }
+    }
+}
+
+// ---------- Static vector ---------------------------------------------------
+
+constexpr size_t PACKET_SIZE = 64;
+
+// Сборка контейнера из PACKET_SIZE элементов для каждого пакета: StaticVector и SmallVector не обращаются к куче
+template <typename Container>
+void RunPacketCase(Runner& runner, const char* container, size_t packets) {
+    runner.Run(Case{ "static_vector", "packet_push_back", container, "uint64", packets }, packets * PACKET_SIZE,
+        [packets] {
+            for (size_t p = 0; p < packets; ++p) {
+                Container values;
+                for (size_t i = 0; i < PACKET_SIZE; ++i) {
+                    values.PushBack(p + i);
+                }
+                DoNotOptimize(values[PACKET_SIZE - 1]);
+            }
+        });
+}
+
+void RunStaticVectorBenchmarks(Runner& runner) {
+    for (size_t packets : runner.Sizes(runner.GetOptions().max_size / PACKET_SIZE)) {
+        RunPacketCase<StaticVector<uint64_t, PACKET_SIZE>>(runner, "StaticVector", packets);
+        RunPacketCase<SmallVector<uint64_t, PACKET_SIZE>>(runner, "SmallVector", packets);
+        RunPacketCase<Vector<uint64_t>>(runner, "Vector", packets);
+    }
+}
+
+// ---------- Concurrent push -------------------------------------------------
+
+constexpr size_t THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+// Запускает threads потоков, каждый добавляет n / threads элементов через push(value)
+template <typename Push>
+void PushFromThreads(size_t threads, size_t n, Push push) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([t, threads, n, &push] {
+            for (size_t i = t; i < n; i += threads) {
+                push(i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void RunConcurrentBenchmarks(Runner& runner) {
+    for (size_t n : SizesFrom(runner, 1000)) {
+        for (size_t threads : THREAD_COUNTS) {
+            const std::string name = "push_back_threads_" + std::to_string(threads);
+            const std::map<std::string, double> metrics = { { "threads", static_cast<double>(threads) } };
+
+            runner.Run(Case{ "concurrent", name, "ConcurrentVector", "uint64", n }, n, [threads, n] {
+                ConcurrentVector<uint64_t> v;
+                PushFromThreads(threads, n, [&v](size_t i) {
+                    v.PushBack(i);
+                });
+                DoNotOptimize(v.Size());
+            }, metrics);
+
+            runner.Run(Case{ "concurrent", name, "Vector+mutex", "uint64", n }, n, [threads, n] {
+                Vector<uint64_t> v;
+                std::mutex mutex;
+                PushFromThreads(threads, n, [&v, &mutex](size_t i) {
+                    std::lock_guard lock(mutex);
+                    v.PushBack(i);
+                });
+                DoNotOptimize(v.Size());
+            }, metrics);
+        }
+    }
+}
+
+// ---------- Push latency ----------------------------------------------------
+
+// Не больше стольких задержек хранится для одного случая
+constexpr size_t MAX_LATENCY_SAMPLES = 4 * 1024 * 1024;
+
+// Задержка каждого добавления по отдельности: паузы на перенос элементов видны в p99/p999 и max
+template <typename Container>
+void RunLatencyCase(Runner& runner, const char* container, size_t n) {
+    const Case bench_case{ "latency", "push_back", container, "uint64", n };
+    if (!runner.Enabled(bench_case)) {
+        return;
+    }
+    const Options& options = runner.GetOptions();
+    const size_t repetitions = std::max<size_t>(1, std::min(options.repetitions, MAX_LATENCY_SAMPLES / n));
+    std::vector<double> samples;
+    samples.reserve(repetitions * n);
+    for (size_t rep = 0; rep < options.warmup + repetitions; ++rep) {
+        Container c;
+        for (size_t i = 0; i < n; ++i) {
+            const Clock::time_point start = Clock::now();
+            c.PushBack(i);
+            const Clock::time_point finish = Clock::now();
+            if (rep >= options.warmup) {
+                samples.push_back(ElapsedNs(start, finish));
+            }
+        }
+        DoNotOptimize(c.Size());
+    }
+    runner.ReportSamples(bench_case, std::move(samples));
+}
+
+void RunLatencyBenchmarks(Runner& runner) {
+    for (size_t n : SizesFrom(runner, 1000)) {
+        RunLatencyCase<Vector<uint64_t>>(runner, "Vector", n);
+        RunLatencyCase<Vector<uint64_t, std::allocator<uint64_t>, IncrementalGrowth<>>>(runner,
+            "Vector<IncrementalGrowth>", n);
+        RunLatencyCase<SegmentedVector<uint64_t>>(runner, "SegmentedVector", n);
+    }
+}
+
+}  // namespace
+
+void RunFeatureBenchmarks(Runner& runner) {
+    RunGrowthBenchmarks(runner);
+    RunGrowthPolicyBenchmarks(runner);
+    RunDefaultInitBenchmarks(runner);
+    RunHugePageBenchmarks(runner);
+    RunNumericBenchmarks(runner);
+    RunParallelBenchmarks(runner);
+    RunStreamingBenchmarks(runner);
+    RunFlatMapBenchmarks(runner);
+    RunGapVectorBenchmarks(runner);
+    RunStaticVectorBenchmarks(runner);
+    RunConcurrentBenchmarks(runner);
+    RunLatencyBenchmarks(runner);
+}
+
+}  // namespace bench
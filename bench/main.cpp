@@ -0,0 +1,49 @@
+#include "bench.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// vector_bench [--format=csv|json] [--filter=<подстрока>] [--max-size=N] [--repetitions=N] [--warmup=N] [--list]
+int main(int argc, char* argv[]) {
+    bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value = [&arg](const std::string& prefix) {
+            return arg.compare(0, prefix.size(), prefix) == 0 ? arg.substr(prefix.size()) : std::string();
+        };
+        if (!value("--format=").empty()) {
+            options.format = value("--format=");
+        }
+        else if (!value("--filter=").empty()) {
+            options.filter = value("--filter=");
+        }
+        else if (!value("--max-size=").empty()) {
+            options.max_size = std::strtoull(value("--max-size=").c_str(), nullptr, 10);
+        }
+        else if (!value("--repetitions=").empty()) {
+            options.repetitions = std::strtoull(value("--repetitions=").c_str(), nullptr, 10);
+        }
+        else if (!value("--warmup=").empty()) {
+            options.warmup = std::strtoull(value("--warmup=").c_str(), nullptr, 10);
+        }
+        else if (arg == "--list") {
+            options.list = true;
+        }
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--format=csv|json] [--filter=SUBSTRING] [--max-size=N] [--repetitions=N] [--warmup=N] [--list]\n";
+            return 1;
+        }
+    }
+    if (options.format != "csv" && options.format != "json") {
+        std::cerr << "Unknown format " << options.format << '\n';
+        return 1;
+    }
+
+    bench::Runner runner(options, std::cout);
+    bench::RunContainerBenchmarks(runner);
+    bench::RunFeatureBenchmarks(runner);
+    runner.Finish();
+    return 0;
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace allocator_detail {
+
+// Как у std::allocator: размер буфера в байтах не превышает PTRDIFF_MAX, поэтому его округление
+// до кратного выравниванию или размеру страницы не переполняет size_t
+template <typename T>
+constexpr size_t MaxElements() noexcept {
+    return static_cast<size_t>(PTRDIFF_MAX) / sizeof(T);
+}
+
+// Проверяет n до вычисления n * sizeof(T): иначе произведение переполняется и выделяется слишком маленький буфер
+template <typename T>
+void CheckElementCount(size_t n) {
+    if (n > MaxElements<T>()) {
+        throw std::bad_array_new_length();
+    }
+}
+
+}  // namespace allocator_detail
+
+// Аллокатор буферов с выравниванием Alignment байт через выравнивающие operator new/delete.
+// Размер буфера округляется вверх до кратного Alignment, поэтому при выравнивании по кэш-линии
+// буфер не делит линии с соседними объектами. Подходит для AVX-ядер (32, 64) и постраничного выравнивания (4096)
+template <typename T, size_t Alignment = std::max(alignof(T), size_t{ 16 })>
+class AlignedAllocator {
+public:
+    static_assert(Alignment >= alignof(T), "Alignment must not be weaker than alignof(T)");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    static constexpr size_t ALIGNMENT = Alignment;
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, std::max(Alignment, alignof(U))>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U, size_t OtherAlignment>
+    AlignedAllocator(const AlignedAllocator<U, OtherAlignment>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        allocator_detail::CheckElementCount<T>(n);
+        return static_cast<T*>(operator new(RoundUp(n * sizeof(T)), std::align_val_t{ Alignment }));
+    }
+
+    void deallocate(T* buf, size_t /*n*/) noexcept {
+        operator delete(buf, std::align_val_t{ Alignment });
+    }
+
+    template <typename U, size_t OtherAlignment>
+    bool operator==(const AlignedAllocator<U, OtherAlignment>& /*other*/) const noexcept {
+        return Alignment == OtherAlignment;
+    }
+
+    template <typename U, size_t OtherAlignment>
+    bool operator!=(const AlignedAllocator<U, OtherAlignment>& /*other*/) const noexcept {
+        return Alignment != OtherAlignment;
+    }
+
+    size_t max_size() const noexcept {
+        return allocator_detail::MaxElements<T>();
+    }
+
+private:
+    static size_t RoundUp(size_t bytes) noexcept {
+        return (bytes + Alignment - 1) / Alignment * Alignment;
+    }
+};
+
+// ----------------------------------------------------------------------------
+
+// Аллокатор на malloc/realloc с поддержкой увеличения буфера на месте (метод reallocate).
+// Буферы от MmapThreshold байт выделяются через mmap и растут через mremap(MREMAP_MAYMOVE):
+// ядро переназначает страницы, и данные не копируются. Предназначен для тривиально перемещаемых типов,
+// для остальных RawMemory метод reallocate не использует
+template <typename T, size_t MmapThreshold = 1024 * 1024>
+class ReallocAllocator {
+public:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "ReallocAllocator does not support over-aligned types");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = ReallocAllocator<U, MmapThreshold>;
+    };
+
+    ReallocAllocator() noexcept = default;
+
+    template <typename U>
+    ReallocAllocator(const ReallocAllocator<U, MmapThreshold>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        allocator_detail::CheckElementCount<T>(n);
+        const size_t bytes = n * sizeof(T);
+        void* buf = IsMapped(bytes) ? Map(bytes) : std::malloc(bytes);
+        if (buf == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(buf);
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (IsMapped(bytes)) {
+            Unmap(buf, bytes);
+        }
+        else {
+            std::free(buf);
+        }
+    }
+
+    // Изменяет размер буфера, сохраняя первые min(old_n, new_n) элементов побайтово.
+    // При ошибке выбрасывает std::bad_alloc, исходный буфер остаётся нетронутым
+    T* reallocate(T* buf, size_t old_n, size_t new_n) {
+        allocator_detail::CheckElementCount<T>(new_n);
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = new_n * sizeof(T);
+        void* result = nullptr;
+
+        if (IsMapped(old_bytes) && IsMapped(new_bytes)) {
+            result = Remap(buf, old_bytes, new_bytes);
+        }
+        else if (!IsMapped(old_bytes) && !IsMapped(new_bytes)) {
+            result = std::realloc(static_cast<void*>(buf), new_bytes);
+        }
+        else {
+            // Переход между malloc и mmap требует копирования
+            result = IsMapped(new_bytes) ? Map(new_bytes) : std::malloc(new_bytes);
+            if (result != nullptr) {
+                std::memcpy(result, static_cast<const void*>(buf), old_bytes < new_bytes ? old_bytes : new_bytes);
+                deallocate(buf, old_n);
+            }
+        }
+
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(result);
+    }
+
+    template <typename U>
+    bool operator==(const ReallocAllocator<U, MmapThreshold>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const ReallocAllocator<U, MmapThreshold>& /*other*/) const noexcept {
+        return false;
+    }
+
+    size_t max_size() const noexcept {
+        return allocator_detail::MaxElements<T>();
+    }
+
+private:
+#if defined(__linux__)
+    static bool IsMapped(size_t bytes) noexcept {
+        return bytes >= MmapThreshold;
+    }
+
+    static size_t PageSize() noexcept {
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return page_size;
+    }
+
+    static size_t RoundToPages(size_t bytes) noexcept {
+        return (bytes + PageSize() - 1) / PageSize() * PageSize();
+    }
+
+    static void* Map(size_t bytes) noexcept {
+        void* buf = mmap(nullptr, RoundToPages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return buf != MAP_FAILED ? buf : nullptr;
+    }
+
+    static void* Remap(void* buf, size_t old_bytes, size_t new_bytes) noexcept {
+        void* result = mremap(buf, RoundToPages(old_bytes), RoundToPages(new_bytes), MREMAP_MAYMOVE);
+        return result != MAP_FAILED ? result : nullptr;
+    }
+
+    static void Unmap(void* buf, size_t bytes) noexcept {
+        munmap(buf, RoundToPages(bytes));
+    }
+#else
+    // Без mremap все буферы обслуживаются через malloc/realloc
+    static bool IsMapped(size_t /*bytes*/) noexcept {
+        return false;
+    }
+
+    static void* Map(size_t bytes) noexcept {
+        return std::malloc(bytes);
+    }
+
+    static void* Remap(void* buf, size_t /*old_bytes*/, size_t new_bytes) noexcept {
+        return std::realloc(buf, new_bytes);
+    }
+
+    static void Unmap(void* buf, size_t /*bytes*/) noexcept {
+        std::free(buf);
+    }
+#endif
+};
+
+// ----------------------------------------------------------------------------
+
+// Аллокатор, размещающий буферы от Threshold байт в анонимных отображениях, выровненных по 2 МиБ,
+// с madvise(MADV_HUGEPAGE): ядро может подложить прозрачные большие страницы и сократить промахи TLB
+// при случайном доступе. Если THP недоступны, отображение работает на обычных страницах.
+// Буферы меньше порога выделяются через operator new
+template <typename T, size_t Threshold = 2 * 1024 * 1024>
+class HugePageAllocator {
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    static constexpr size_t THRESHOLD = Threshold;
+
+    static_assert(alignof(T) <= HUGE_PAGE_SIZE);
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, Threshold>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, Threshold>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        allocator_detail::CheckElementCount<T>(n);
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            return static_cast<T*>(operator new(bytes, std::align_val_t{ alignof(T) }));
+        }
+        void* buf = Map(RoundUp(bytes));
+        if (buf == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(buf);
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            operator delete(buf, std::align_val_t{ alignof(T) });
+            return;
+        }
+        Unmap(buf, RoundUp(bytes));
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U, Threshold>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U, Threshold>& /*other*/) const noexcept {
+        return false;
+    }
+
+    size_t max_size() const noexcept {
+        return allocator_detail::MaxElements<T>();
+    }
+
+private:
+    static size_t RoundUp(size_t bytes) noexcept {
+        return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+#if defined(__linux__)
+    static bool IsMapped(size_t bytes) noexcept {
+        return bytes >= Threshold;
+    }
+
+    // Отображает область с запасом в одну большую страницу и обрезает края, чтобы начало было выровнено по 2 МиБ
+    static void* Map(size_t bytes) noexcept {
+        const size_t mapped_bytes = bytes + HUGE_PAGE_SIZE;
+        void* mapped = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) {
+            return nullptr;
+        }
+        std::byte* begin = static_cast<std::byte*>(mapped);
+        std::byte* aligned = begin + (HUGE_PAGE_SIZE - reinterpret_cast<uintptr_t>(begin) % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+        if (aligned != begin) {
+            munmap(begin, aligned - begin);
+        }
+        std::byte* end = begin + mapped_bytes;
+        if (aligned + bytes != end) {
+            munmap(aligned + bytes, end - (aligned + bytes));
+        }
+#if defined(MADV_HUGEPAGE)
+        madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+        return aligned;
+    }
+
+    static void Unmap(void* buf, size_t bytes) noexcept {
+        munmap(buf, bytes);
+    }
+#else
+    static bool IsMapped(size_t /*bytes*/) noexcept {
+        return false;
+    }
+
+    static void* Map(size_t /*bytes*/) noexcept {
+        return nullptr;
+    }
+
+    static void Unmap(void* /*buf*/, size_t /*bytes*/) noexcept {
+    }
+#endif
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "raw_memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Вектор с добавлением элементов из нескольких потоков без блокировок.
+// Элементы хранятся в сегментах RawMemory<T, Allocator> экспоненциально растущего размера:
+// сегмент k вмещает FIRST_SEGMENT_SIZE * 2^k элементов и никогда не перемещается, поэтому адреса элементов стабильны.
+// Позиция нового элемента резервируется атомарным fetch_add; после создания элемент публикуется флагом готовности,
+// и его можно читать через operator[] из любого потока, получившего индекс после публикации.
+// Сегменты создаются первым обратившимся к ним потоком через compare_exchange, проигравший поток освобождает свой буфер
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector {
+public:
+    static constexpr size_t FIRST_SEGMENT_SIZE = 64;
+
+    static_assert((FIRST_SEGMENT_SIZE & (FIRST_SEGMENT_SIZE - 1)) == 0, "FIRST_SEGMENT_SIZE must be a power of two");
+
+    ConcurrentVector() = default;
+
+    explicit ConcurrentVector(const Allocator& alloc)
+        : alloc_(alloc)
+    {
+    }
+
+    ConcurrentVector(const ConcurrentVector& other) = delete;
+
+    ConcurrentVector& operator= (const ConcurrentVector& other) = delete;
+
+    // Вызывается, когда другие потоки уже не обращаются к вектору
+    ~ConcurrentVector() {
+        const size_t size = size_.load(std::memory_order_acquire);
+        for (size_t k = 0; k < MAX_SEGMENTS; ++k) {
+            Segment* segment = segments_[k].load(std::memory_order_acquire);
+            if (segment == nullptr) {
+                continue;
+            }
+            const size_t first = SegmentStart(k);
+            const size_t count = first < size ? std::min(SegmentCapacity(k), size - first) : 0;
+            for (size_t offset = 0; offset < count; ++offset) {
+                if (segment->ready[offset].load(std::memory_order_relaxed)) {
+                    std::destroy_at(segment->data + offset);
+                }
+            }
+            delete segment;
+        }
+    }
+
+    // Количество зарезервированных позиций. Элементы с меньшими индексами могут ещё создаваться другими потоками
+    size_t Size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Создан ли элемент с индексом index и видны ли его данные текущему потоку
+    bool IsPublished(size_t index) const noexcept {
+        if (index >= Size()) {
+            return false;
+        }
+        const auto [k, offset] = Locate(index);
+        const Segment* segment = segments_[k].load(std::memory_order_acquire);
+        return segment != nullptr && segment->ready[offset].load(std::memory_order_acquire);
+    }
+
+    // Элемент должен быть опубликован
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<ConcurrentVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(IsPublished(index));
+        const auto [k, offset] = Locate(index);
+        return segments_[k].load(std::memory_order_acquire)->data[offset];
+    }
+
+    // Заранее создаёт сегменты для первых capacity элементов. Потокобезопасен
+    void Reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        const size_t last_segment = Locate(capacity - 1).first;
+        for (size_t k = 0; k <= last_segment; ++k) {
+            GetOrCreateSegment(k);
+        }
+    }
+
+    // Потокобезопасны. Возвращают индекс нового элемента.
+    // Если конструктор выбросит исключение, зарезервированная позиция остаётся неопубликованной
+    size_t PushBack(const T& value) {
+        return EmplaceBack(value);
+    }
+
+    size_t PushBack(T&& value) {
+        return EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        const auto [k, offset] = Locate(index);
+        Segment* segment = GetOrCreateSegment(k);
+        new (segment->data + offset) T(std::forward<Args>(args)...);
+        segment->ready[offset].store(true, std::memory_order_release);
+        return index;
+    }
+
+private:
+    struct Segment {
+        Segment(size_t capacity, const Allocator& alloc)
+            : data(capacity, alloc)
+            , ready(new std::atomic<bool>[capacity]())
+        {
+        }
+
+        RawMemory<T, Allocator> data;
+        std::unique_ptr<std::atomic<bool>[]> ready;
+    };
+
+    static constexpr size_t Log2(size_t value) noexcept {
+        size_t result = 0;
+        while (value >>= 1) {
+            ++result;
+        }
+        return result;
+    }
+
+    static constexpr size_t FIRST_SEGMENT_LOG = Log2(FIRST_SEGMENT_SIZE);
+    static constexpr size_t MAX_SEGMENTS = sizeof(size_t) * 8 - FIRST_SEGMENT_LOG;
+
+    static size_t SegmentCapacity(size_t k) noexcept {
+        return FIRST_SEGMENT_SIZE << k;
+    }
+
+    // Индекс первого элемента сегмента k
+    static size_t SegmentStart(size_t k) noexcept {
+        return FIRST_SEGMENT_SIZE * ((size_t{ 1 } << k) - 1);
+    }
+
+    // Номер сегмента и смещение в нём для элемента index
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        const size_t chunk = (index >> FIRST_SEGMENT_LOG) + 1;
+#if defined(__GNUC__)
+        const size_t k = sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(chunk);
+#else
+        const size_t k = Log2(chunk);
+#endif
+        assert(k < MAX_SEGMENTS);
+        return { k, index - SegmentStart(k) };
+    }
+
+    Segment* GetOrCreateSegment(size_t k) {
+        Segment* segment = segments_[k].load(std::memory_order_acquire);
+        if (segment != nullptr) {
+            return segment;
+        }
+        auto candidate = std::make_unique<Segment>(SegmentCapacity(k), alloc_);
+        if (segments_[k].compare_exchange_strong(segment, candidate.get(), std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+            return candidate.release();
+        }
+        return segment;
+    }
+
+    Allocator alloc_;
+    std::atomic<Segment*> segments_[MAX_SEGMENTS] = {};
+    // Счётчик на отдельной кэш-линии, чтобы fetch_add не вытеснял из кэшей читаемые указатели на сегменты
+    alignas(64) std::atomic<size_t> size_ = 0;
+};
@@ -0,0 +1,592 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Упорядоченные ассоциативные контейнеры FlatSet и FlatMap на отсортированных Vector.
+// Ключи лежат в памяти подряд (у FlatMap значения хранятся в отдельном Vector), поэтому поиск проходит
+// по плотному массиву, а не по узлам в куче. Поиск — O(log n), вставка и удаление одного ключа — O(n);
+// контейнеры рассчитаны на таблицы, которые строятся целиком (конструктор, InsertMany) и затем в основном читаются
+
+// ---------- Lookup policies -------------------------------------------------
+
+// Стратегия поиска задаёт класс Index<K, Compare>: Build(keys, size) вызывается после каждого изменения ключей,
+// LowerBound(keys, size, key, comp) возвращает позицию первого ключа, не меньшего key
+
+// Двоичный поиск std::lower_bound
+struct BinaryLookup {
+    template <typename K, typename Compare>
+    class Index {
+    public:
+        void Build(const K* /*keys*/, size_t /*size*/) noexcept {
+        }
+
+        size_t LowerBound(const K* keys, size_t size, const K& key, const Compare& comp) const {
+            return std::lower_bound(keys, keys + size, key, comp) - keys;
+        }
+    };
+};
+
+// Двоичный поиск без условных переходов: выбор половины компилируется в условную пересылку (cmov),
+// и на случайных запросах нет ошибок предсказания переходов
+struct BranchlessLookup {
+    template <typename K, typename Compare>
+    class Index {
+    public:
+        void Build(const K* /*keys*/, size_t /*size*/) noexcept {
+        }
+
+        size_t LowerBound(const K* keys, size_t size, const K& key, const Compare& comp) const {
+            if (size == 0) {
+                return 0;
+            }
+            const K* base = keys;
+            while (size > 1) {
+                const size_t half = size / 2;
+                base = comp(base[half], key) ? base + half : base;
+                size -= half;
+            }
+            return static_cast<size_t>(base - keys) + static_cast<size_t>(comp(*base, key));
+        }
+    };
+};
+
+// Раскладка Эйтцингера: копия ключей в порядке обхода в ширину неявного двоичного дерева поиска.
+// Верхние уровни дерева, через которые проходит каждый поиск, лежат рядом и остаются в кэше,
+// а спуск не содержит условных переходов. Требует копии ключей и их позиций (построение O(n) после каждого изменения).
+// Если построить индекс не удалось (нехватка памяти или исключение копирования ключа), поиск выполняется двоичным
+struct EytzingerLookup {
+    template <typename K, typename Compare>
+    class Index {
+    public:
+        void Build(const K* keys, size_t size) noexcept {
+            valid_ = false;
+            try {
+                Vector<size_t> ranks(size);
+                FillRanks(ranks, 0, 1);
+                Vector<K> layout;
+                layout.Reserve(size);
+                for (size_t rank : ranks) {
+                    layout.EmplaceBack(keys[rank]);
+                }
+                ranks_ = std::move(ranks);
+                layout_ = std::move(layout);
+                valid_ = true;
+            }
+            catch (...) {
+            }
+        }
+
+        size_t LowerBound(const K* keys, size_t size, const K& key, const Compare& comp) const {
+            if (!valid_) {
+                return std::lower_bound(keys, keys + size, key, comp) - keys;
+            }
+            // Узел k хранится в layout_[k - 1], его потомки — узлы 2k и 2k + 1
+            const K* layout = layout_.Data();
+            size_t k = 1;
+            while (k <= size) {
+#if defined(__GNUC__)
+                // Потомки на PREFETCH_LEVELS уровней ниже лежат подряд: загружаются заранее, пока идёт спуск
+                __builtin_prefetch(layout + std::min(k << PREFETCH_LEVELS, size) - 1);
+#endif
+                k = 2 * k + static_cast<size_t>(comp(layout[k - 1], key));
+            }
+            // Спуск закончился серией шагов вправо после последнего шага влево; узел перед этим шагом — ответ
+#if defined(__GNUC__)
+            k >>= __builtin_ffsll(static_cast<long long>(~k));
+#else
+            while ((k & 1) != 0) {
+                k >>= 1;
+            }
+            k >>= 1;
+#endif
+            return k == 0 ? size : ranks_[k - 1];
+        }
+
+    private:
+        static constexpr size_t PREFETCH_LEVELS = 4;
+
+        // Обход узлов дерева в симметричном порядке присваивает им позиции ключей по возрастанию
+        static size_t FillRanks(Vector<size_t>& ranks, size_t rank, size_t k) noexcept {
+            if (k <= ranks.Size()) {
+                rank = FillRanks(ranks, rank, 2 * k);
+                ranks[k - 1] = rank++;
+                rank = FillRanks(ranks, rank, 2 * k + 1);
+            }
+            return rank;
+        }
+
+        Vector<K> layout_;
+        Vector<size_t> ranks_;  // позиция ключа узла k в отсортированном массиве — ranks_[k - 1]
+        bool valid_ = true;
+    };
+};
+
+// ---------- FlatSet ---------------------------------------------------------
+
+template <typename K, typename Compare = std::less<K>, typename Lookup = BinaryLookup>
+class FlatSet {
+    // Если перенос ключа может выбросить исключение, при слиянии существующие ключи копируются
+    static constexpr bool NOTHROW_TRANSFER = std::is_nothrow_move_constructible_v<K>;
+
+public:
+    using const_iterator = const K*;
+
+    const_iterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return keys_.end();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp)
+        : comp_(comp)
+    {
+    }
+
+    // Построение из неотсортированного диапазона: сортировка и удаление повторов за один проход
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare())
+        : keys_(first, last)
+        , comp_(comp)
+    {
+        SortUnique(keys_);
+        index_.Build(keys_.Data(), keys_.Size());
+    }
+
+    FlatSet(std::initializer_list<K> init, const Compare& comp = Compare())
+        : FlatSet(init.begin(), init.end(), comp)
+    {
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    // Отсортированные ключи без повторов
+    const Vector<K>& Keys() const noexcept {
+        return keys_;
+    }
+
+    // Позиция первого ключа, не меньшего key
+    size_t LowerBound(const K& key) const {
+        return index_.LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    const_iterator Find(const K& key) const {
+        const size_t pos = LowerBound(key);
+        return pos < Size() && !comp_(key, keys_[pos]) ? begin() + pos : end();
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+
+    // Возвращает false, если такой ключ уже есть
+    bool Insert(K key) {
+        const size_t pos = LowerBound(key);
+        if (pos < Size() && !comp_(key, keys_[pos])) {
+            return false;
+        }
+        keys_.Insert(keys_.cbegin() + pos, std::move(key));
+        index_.Build(keys_.Data(), keys_.Size());
+        return true;
+    }
+
+    // Вставка диапазона за O(n + m log m): новые ключи сортируются и сливаются с существующими
+    // за один проход вместо m сдвигов. Строгая гарантия безопасности исключений. Возвращает число добавленных ключей
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    size_t InsertMany(InputIt first, InputIt last) {
+        Vector<K> batch(first, last);
+        SortUnique(batch);
+        Vector<K> merged;
+        merged.Reserve(keys_.Size() + batch.Size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.Size() || j < batch.Size()) {
+            if (j == batch.Size() || (i < keys_.Size() && !comp_(batch[j], keys_[i]))) {
+                // Существующий ключ идёт первым; равный ему новый ключ пропускается
+                if (j < batch.Size() && i < keys_.Size() && !comp_(keys_[i], batch[j])) {
+                    ++j;
+                }
+                merged.EmplaceBack(TakeExisting(keys_[i++]));
+            }
+            else {
+                merged.EmplaceBack(std::move(batch[j++]));
+            }
+        }
+        const size_t inserted = merged.Size() - keys_.Size();
+        keys_.Swap(merged);
+        index_.Build(keys_.Data(), keys_.Size());
+        return inserted;
+    }
+
+    size_t Erase(const K& key) {
+        const_iterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        keys_.Erase(it);
+        index_.Build(keys_.Data(), keys_.Size());
+        return 1;
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        index_.Build(keys_.Data(), 0);
+    }
+
+    void Swap(FlatSet& other) noexcept {
+        using std::swap;
+        keys_.Swap(other.keys_);
+        swap(comp_, other.comp_);
+        swap(index_, other.index_);
+    }
+
+private:
+    void SortUnique(Vector<K>& keys) const {
+        std::sort(keys.begin(), keys.end(), comp_);
+        const auto last = std::unique(keys.begin(), keys.end(), [this](const K& lhs, const K& rhs) {
+            return !comp_(lhs, rhs);
+        });
+        keys.Erase(last, keys.end());
+    }
+
+    static decltype(auto) TakeExisting(K& key) noexcept {
+        if constexpr (NOTHROW_TRANSFER) {
+            return std::move(key);
+        }
+        else {
+            return static_cast<const K&>(key);
+        }
+    }
+
+    Vector<K> keys_;
+    Compare comp_;
+    typename Lookup::template Index<K, Compare> index_;
+};
+
+// ---------- FlatMap ---------------------------------------------------------
+
+template <typename K, typename V, typename Compare = std::less<K>, typename Lookup = BinaryLookup>
+class FlatMap {
+    // Если перенос ключа или значения может выбросить исключение, при слиянии существующие записи копируются
+    static constexpr bool NOTHROW_TRANSFER =
+        std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>;
+
+public:
+// ---------- Iterator --------------------------------------------------------
+    // Итератор по записям в порядке ключей; разыменование возвращает пару ссылок на ключ и значение
+    template <bool Const>
+    class BasicIterator {
+        using Owner = std::conditional_t<Const, const FlatMap, FlatMap>;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const K&, std::conditional_t<Const, const V&, V&>>;
+        using pointer = void;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return reference(owner_->keys_[index_], owner_->values_[index_]);
+        }
+
+        const K& Key() const noexcept {
+            return owner_->keys_[index_];
+        }
+
+        std::conditional_t<Const, const V&, V&> Value() const noexcept {
+            return owner_->values_[index_];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator result = *this;
+            ++index_;
+            return result;
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+    private:
+        friend class FlatMap;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, Size());
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, Size());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- FlatMap ---------------------------------------------------------
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_(comp)
+    {
+    }
+
+    // Построение из неотсортированного диапазона пар: сортировка, затем за один проход удаление повторов
+    // (остаётся первая пара с данным ключом) и разделение на ключи и значения
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        Vector<std::pair<K, V>> items(first, last);
+        SortUnique(items, keys_, values_);
+        index_.Build(keys_.Data(), keys_.Size());
+    }
+
+    FlatMap(std::initializer_list<std::pair<K, V>> init, const Compare& comp = Compare())
+        : FlatMap(init.begin(), init.end(), comp)
+    {
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    // Отсортированные ключи; значение ключа Keys()[i] — Values()[i]
+    const Vector<K>& Keys() const noexcept {
+        return keys_;
+    }
+
+    const Vector<V>& Values() const noexcept {
+        return values_;
+    }
+
+    // Значения можно изменять на месте: порядок записей от них не зависит
+    Vector<V>& Values() noexcept {
+        return values_;
+    }
+
+    // Позиция первого ключа, не меньшего key
+    size_t LowerBound(const K& key) const {
+        return index_.LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    iterator Find(const K& key) {
+        return iterator(this, FindIndex(key));
+    }
+
+    const_iterator Find(const K& key) const {
+        return const_iterator(this, FindIndex(key));
+    }
+
+    bool Contains(const K& key) const {
+        return FindIndex(key) != Size();
+    }
+
+    V& At(const K& key) {
+        const size_t pos = FindIndex(key);
+        if (pos == Size()) {
+            throw std::out_of_range("Key is not in the FlatMap");
+        }
+        return values_[pos];
+    }
+
+    const V& At(const K& key) const {
+        return const_cast<FlatMap&>(*this).At(key);
+    }
+
+    // Значение ключа; если ключа нет, добавляется значение по умолчанию
+    V& operator[](const K& key) {
+        return Emplace(key).first.Value();
+    }
+
+    // Добавляет запись, если ключа ещё нет; возвращает итератор на запись ключа и признак добавления.
+    // Строгая гарантия безопасности исключений
+    template <typename... Args>
+    std::pair<iterator, bool> Emplace(K key, Args&&... args) {
+        const size_t pos = LowerBound(key);
+        if (pos < Size() && !comp_(key, keys_[pos])) {
+            return { iterator(this, pos), false };
+        }
+        keys_.Emplace(keys_.cbegin() + pos, std::move(key));
+        try {
+            values_.Emplace(values_.cbegin() + pos, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            keys_.Erase(keys_.cbegin() + pos);
+            throw;
+        }
+        index_.Build(keys_.Data(), keys_.Size());
+        return { iterator(this, pos), true };
+    }
+
+    bool Insert(K key, V value) {
+        return Emplace(std::move(key), std::move(value)).second;
+    }
+
+    // Вставка диапазона пар за O(n + m log m): новые записи сортируются и сливаются с существующими
+    // за один проход вместо m сдвигов. Записи с уже существующими ключами пропускаются.
+    // Строгая гарантия безопасности исключений. Возвращает число добавленных записей
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    size_t InsertMany(InputIt first, InputIt last) {
+        Vector<K> batch_keys;
+        Vector<V> batch_values;
+        {
+            Vector<std::pair<K, V>> items(first, last);
+            SortUnique(items, batch_keys, batch_values);
+        }
+        Vector<K> merged_keys;
+        Vector<V> merged_values;
+        merged_keys.Reserve(keys_.Size() + batch_keys.Size());
+        merged_values.Reserve(keys_.Size() + batch_keys.Size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.Size() || j < batch_keys.Size()) {
+            if (j == batch_keys.Size() || (i < keys_.Size() && !comp_(batch_keys[j], keys_[i]))) {
+                // Существующая запись идёт первой; новая запись с равным ключом пропускается
+                if (j < batch_keys.Size() && i < keys_.Size() && !comp_(keys_[i], batch_keys[j])) {
+                    ++j;
+                }
+                merged_keys.EmplaceBack(TakeExisting(keys_[i]));
+                merged_values.EmplaceBack(TakeExisting(values_[i]));
+                ++i;
+            }
+            else {
+                merged_keys.EmplaceBack(std::move(batch_keys[j]));
+                merged_values.EmplaceBack(std::move(batch_values[j]));
+                ++j;
+            }
+        }
+        const size_t inserted = merged_keys.Size() - keys_.Size();
+        keys_.Swap(merged_keys);
+        values_.Swap(merged_values);
+        index_.Build(keys_.Data(), keys_.Size());
+        return inserted;
+    }
+
+    size_t Erase(const K& key) {
+        const size_t pos = FindIndex(key);
+        if (pos == Size()) {
+            return 0;
+        }
+        keys_.Erase(keys_.cbegin() + pos);
+        values_.Erase(values_.cbegin() + pos);
+        index_.Build(keys_.Data(), keys_.Size());
+        return 1;
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+        index_.Build(keys_.Data(), 0);
+    }
+
+    void Swap(FlatMap& other) noexcept {
+        using std::swap;
+        keys_.Swap(other.keys_);
+        values_.Swap(other.values_);
+        swap(comp_, other.comp_);
+        swap(index_, other.index_);
+    }
+
+private:
+    size_t FindIndex(const K& key) const {
+        const size_t pos = LowerBound(key);
+        return pos < Size() && !comp_(key, keys_[pos]) ? pos : Size();
+    }
+
+    // Сортирует пары по ключу (устойчиво, чтобы из повторов осталась первая пара) и раскладывает их по keys и values
+    void SortUnique(Vector<std::pair<K, V>>& items, Vector<K>& keys, Vector<V>& values) const {
+        std::stable_sort(items.begin(), items.end(), [this](const auto& lhs, const auto& rhs) {
+            return comp_(lhs.first, rhs.first);
+        });
+        keys.Reserve(items.Size());
+        values.Reserve(items.Size());
+        for (auto& [key, value] : items) {
+            if (keys.Size() == 0 || comp_(keys[keys.Size() - 1], key)) {
+                keys.EmplaceBack(std::move(key));
+                values.EmplaceBack(std::move(value));
+            }
+        }
+    }
+
+    template <typename U>
+    static decltype(auto) TakeExisting(U& value) noexcept {
+        if constexpr (NOTHROW_TRANSFER) {
+            return std::move(value);
+        }
+        else {
+            return static_cast<const U&>(value);
+        }
+    }
+
+    Vector<K> keys_;
+    Vector<V> values_;
+    Compare comp_;
+    typename Lookup::template Index<K, Compare> index_;
+};
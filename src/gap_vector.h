@@ -0,0 +1,444 @@
+#pragma once
+
+#include "instrumentation.h"
+#include "raw_memory.h"
+#include "growth_policy.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор с разрывом (gap buffer): элементы хранятся в одном буфере RawMemory<T, Allocator> двумя частями,
+// между которыми находится неинициализированный разрыв. Вставка и удаление выполняются на месте разрыва,
+// а перед операцией разрыв переносится к нужной позиции перемещением элементов между позицией и разрывом.
+// Поэтому серия вставок и удалений рядом с одной позицией (курсором) стоит O(1) амортизированно,
+// а не O(n) на каждую операцию, как у Vector. Compact() возвращает элементы в виде непрерывного Vector
+template <typename T, typename Allocator = std::allocator<T>>
+class GapVector {
+    // Перенос элементов через разрыв не должен выбрасывать исключений
+    static_assert(IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>,
+        "GapVector requires a nothrow move constructible or trivially relocatable type");
+
+public:
+// ---------- Iterator --------------------------------------------------------
+    // Итератор произвольного доступа по логическим позициям: хранит индекс элемента, а не адрес, поэтому
+    // остаётся действительным при перемещении разрыва и росте буфера
+    template <bool Const>
+    class BasicIterator {
+        using Owner = std::conditional_t<Const, const GapVector, GapVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator result = *this;
+            ++index_;
+            return result;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator result = *this;
+            --index_;
+            return result;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        friend class GapVector;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, Size());
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, Size());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- GapVector -------------------------------------------------------
+    GapVector() = default;
+
+    explicit GapVector(const Allocator& alloc)
+        : data_(alloc)
+    {
+    }
+
+    GapVector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : GapVector(init.begin(), init.end(), alloc)
+    {
+    }
+
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    GapVector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : data_(alloc)
+    {
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+    }
+
+    GapVector(const GapVector& other)
+        : data_(other.Size(), std::allocator_traits<Allocator>::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+        other.CopyTo(data_.GetAddress());
+        gap_begin_ = other.Size();
+        gap_end_ = other.Size();
+    }
+
+    GapVector(GapVector&& other) noexcept {
+        Swap(other);
+    }
+
+    GapVector& operator= (const GapVector& other) {
+        if (this != &other) {
+            GapVector tmp(other);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    GapVector& operator= (GapVector&& other) noexcept {
+        if (this != &other) {
+            GapVector tmp(std::move(other));
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    ~GapVector() {
+        Clear();
+    }
+
+    size_t Size() const noexcept {
+        return data_.Capacity() - GapSize();
+    }
+
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    // Логическая позиция разрыва: следующая вставка в эту позицию не перемещает элементов
+    size_t GapPosition() const noexcept {
+        return gap_begin_;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<GapVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return data_[index < gap_begin_ ? index : index + GapSize()];
+    }
+
+    void Swap(GapVector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(gap_begin_, other.gap_begin_);
+        std::swap(gap_end_, other.gap_end_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > data_.Capacity()) {
+            Grow(new_capacity);
+        }
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(data_.GetAddress(), gap_begin_);
+        std::destroy_n(data_.GetAddress() + gap_end_, SuffixSize());
+        gap_begin_ = 0;
+        gap_end_ = data_.Capacity();
+    }
+
+    // Строгая гарантия безопасности исключений; при вставке в позицию разрыва элементы не перемещаются
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t shift = CheckedPosition(pos, Size());
+        if (shift == gap_begin_ && GapSize() != 0) {
+            new (data_ + gap_begin_) T(std::forward<Args>(args)...);
+        }
+        else {
+            // Элемент создаётся до переноса разрыва, так как аргументы могут ссылаться на элементы вектора
+            T value(std::forward<Args>(args)...);
+            if (GapSize() == 0) {
+                Grow(GrowthPolicy::template NextCapacity<T>(data_.Capacity(), data_.Capacity() + 1));
+            }
+            MoveGap(shift);
+            new (data_ + gap_begin_) T(std::move(value));
+        }
+        ++gap_begin_;
+        return begin() + shift;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return *Emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() noexcept {
+        assert(Size() != 0);
+        MoveGap(Size() - 1);
+        std::destroy_at(data_ + gap_end_);
+        ++gap_end_;
+    }
+
+    iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    // Разрыв переносится к first и поглощает удаляемые элементы
+    iterator Erase(const_iterator first, const_iterator last) {
+        if (first > last) {
+            throw std::range_error("Pos value is outside the GapVector");
+        }
+        const size_t shift = CheckedPosition(first, Size());
+        const size_t count = CheckedPosition(last, Size()) - shift;
+        MoveGap(shift);
+        std::destroy_n(data_ + gap_end_, count);
+        gap_end_ += count;
+        return begin() + shift;
+    }
+
+    // Копия элементов в виде непрерывного Vector
+    Vector<T, Allocator> Compact() const& {
+        Vector<T, Allocator> result(
+            std::allocator_traits<Allocator>::select_on_container_copy_construction(data_.GetAllocator()));
+        result.ResizeWith(Size(), [this](T* first, size_t /*count*/) {
+            CopyTo(first);
+        });
+        return result;
+    }
+
+    // Переносит элементы в непрерывный Vector без копирования; GapVector становится пустым
+    Vector<T, Allocator> Compact() && {
+        Vector<T, Allocator> result(data_.GetAllocator());
+        result.ResizeWith(Size(), [this](T* first, size_t /*count*/) noexcept {
+            Relocate(data_.GetAddress(), gap_begin_, first);
+            Relocate(data_.GetAddress() + gap_end_, SuffixSize(), first + gap_begin_);
+            gap_begin_ = 0;
+            gap_end_ = data_.Capacity();
+        });
+        return result;
+    }
+
+private:
+    using GrowthPolicy = DoublingGrowth;
+
+    size_t GapSize() const noexcept {
+        return gap_end_ - gap_begin_;
+    }
+
+    size_t SuffixSize() const noexcept {
+        return data_.Capacity() - gap_end_;
+    }
+
+    static size_t CheckedPosition(const_iterator pos, size_t size) {
+        if (pos.index_ > size) {
+            throw std::range_error("Pos value is outside the GapVector");
+        }
+        return pos.index_;
+    }
+
+    // Копирует элементы подряд в неинициализированную память to; при исключении созданные копии разрушаются
+    void CopyTo(T* to) const {
+        T* middle = std::uninitialized_copy_n(data_.GetAddress(), gap_begin_, to);
+        try {
+            std::uninitialized_copy_n(data_.GetAddress() + gap_end_, SuffixSize(), middle);
+        }
+        catch (...) {
+            std::destroy(to, middle);
+            throw;
+        }
+    }
+
+    // Переносит разрыв к логической позиции pos, перемещая элементы между pos и разрывом на другую его сторону
+    void MoveGap(size_t pos) noexcept {
+        if (pos < gap_begin_) {
+            const size_t count = gap_begin_ - pos;
+            VECTOR_COUNT(ELEMENTS_SHIFTED, count);
+            Relocate(data_.GetAddress() + pos, count, data_.GetAddress() + gap_end_ - count);
+            gap_begin_ -= count;
+            gap_end_ -= count;
+        }
+        else if (pos > gap_begin_) {
+            const size_t count = pos - gap_begin_;
+            VECTOR_COUNT(ELEMENTS_SHIFTED, count);
+            Relocate(data_.GetAddress() + gap_end_, count, data_.GetAddress() + gap_begin_);
+            gap_begin_ += count;
+            gap_end_ += count;
+        }
+    }
+
+    // Новый буфер вместимостью new_capacity; разрыв остаётся на прежней логической позиции и расширяется
+    void Grow(size_t new_capacity) {
+        RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+        const size_t suffix_size = SuffixSize();
+        Relocate(data_.GetAddress(), gap_begin_, new_data.GetAddress());
+        Relocate(data_.GetAddress() + gap_end_, suffix_size, new_data.GetAddress() + new_capacity - suffix_size);
+        gap_end_ = new_capacity - suffix_size;
+        data_.Swap(new_data);
+    }
+
+    // Переносит count элементов в неинициализированную память to; диапазоны могут перекрываться
+    static void Relocate(T* from, size_t count, T* to) noexcept {
+        if (count == 0 || from == to) {
+            return;
+        }
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            std::memmove(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        }
+        else if (to < from) {
+            for (size_t i = 0; i < count; ++i) {
+                new (to + i) T(std::move(from[i]));
+                std::destroy_at(from + i);
+            }
+        }
+        else {
+            for (size_t i = count; i-- > 0;) {
+                new (to + i) T(std::move(from[i]));
+                std::destroy_at(from + i);
+            }
+        }
+    }
+
+    RawMemory<T, Allocator> data_;
+    size_t gap_begin_ = 0;  // элементы [0, gap_begin_) и [gap_end_, Capacity()) буфера
+    size_t gap_end_ = 0;
+};
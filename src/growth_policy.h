@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+// Политики роста вместимости вектора. Политика предоставляет статический метод
+// template <typename T> size_t NextCapacity(size_t capacity, size_t min_capacity),
+// возвращающий новую вместимость не меньше min_capacity при заполненном буфере вместимости capacity
+
+// Рост в Num / Den раз, но не менее чем на один элемент
+template <size_t Num, size_t Den>
+struct FactorGrowth {
+    static_assert(Num > Den, "Growth factor must be greater than one");
+
+    template <typename T>
+    static size_t NextCapacity(size_t capacity, size_t min_capacity) noexcept {
+        return std::max(std::max(capacity + capacity * (Num - Den) / Den, capacity + 1), min_capacity);
+    }
+};
+
+using DoublingGrowth = FactorGrowth<2, 1>;
+using OneAndHalfGrowth = FactorGrowth<3, 2>;
+
+// Первое выделение заполняет не меньше CacheLineSize байт, дальнейший рост определяет Base.
+// Избавляет от цепочки мелких выделений 1, 2, 4, 8 для небольших типов
+template <typename Base = DoublingGrowth, size_t CacheLineSize = 64>
+struct CacheLineGrowth {
+    template <typename T>
+    static size_t NextCapacity(size_t capacity, size_t min_capacity) noexcept {
+        if (capacity == 0) {
+            return std::max(std::max(CacheLineSize / sizeof(T), size_t{ 1 }), min_capacity);
+        }
+        return Base::template NextCapacity<T>(capacity, min_capacity);
+    }
+};
+
+// Округляет размер буфера, выбранный политикой Base, вверх до класса размера аллокатора:
+// до степени двойки (не менее MinClassSize байт) для буферов меньше страницы и до целого числа страниц для остальных.
+// Память, которую аллокатор всё равно отдал бы вектору, становится его вместимостью
+template <typename Base = DoublingGrowth, size_t PageSize = 4096, size_t MinClassSize = 16>
+struct SizeClassGrowth {
+    template <typename T>
+    static size_t NextCapacity(size_t capacity, size_t min_capacity) noexcept {
+        const size_t bytes = Base::template NextCapacity<T>(capacity, min_capacity) * sizeof(T);
+        size_t rounded = MinClassSize;
+        if (bytes < PageSize) {
+            while (rounded < bytes) {
+                rounded *= 2;
+            }
+        }
+        else {
+            rounded = (bytes + PageSize - 1) / PageSize * PageSize;
+        }
+        return rounded / sizeof(T);
+    }
+};
+
+// Постепенный перенос элементов при росте, как при инкрементальном рехешировании хеш-таблиц.
+// Vector выделяет новый буфер, но переносит в него не больше Step старых элементов за каждое последующее
+// добавление в конец (или больше, если иначе перенос не завершится до следующего роста). Вместимость выбирает Base.
+// Политика должна быть внешней: обёртки вроде SizeClassGrowth<IncrementalGrowth<>> постепенный перенос отключают
+// Во время переноса константные Data() и итераторы недоступны (assert): const Vector& читается через VisitParts
+template <typename Base = DoublingGrowth, size_t Step = 4>
+struct IncrementalGrowth {
+    static_assert(Step > 0, "Migration step must be positive");
+
+    static constexpr size_t MIGRATION_STEP = Step;
+
+    template <typename T>
+    static size_t NextCapacity(size_t capacity, size_t min_capacity) noexcept {
+        return Base::template NextCapacity<T>(capacity, min_capacity);
+    }
+};
+
+// Количество элементов, переносимых за одно добавление; 0 для политик без постепенного переноса
+template <typename Policy, typename = void>
+struct MigrationStep : std::integral_constant<size_t, 0> {
+};
+
+template <typename Policy>
+struct MigrationStep<Policy, std::void_t<decltype(Policy::MIGRATION_STEP)>>
+    : std::integral_constant<size_t, Policy::MIGRATION_STEP> {
+};
+
+template <typename Policy>
+inline constexpr size_t MigrationStepV = MigrationStep<Policy>::value;
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+// Счётчики выделений памяти и перемещений элементов в RawMemory и Vector.
+// Включаются определением макроса VECTOR_INSTRUMENTATION (опция CMake с тем же именем) во всех единицах трансляции;
+// без него макрос VECTOR_COUNT не вычисляет аргументы и не порождает кода, а снимки счётчиков нулевые.
+// Каждое событие учитывается в глобальных счётчиках и в счётчиках метки, активной в текущем потоке (TagScope)
+
+namespace instrumentation {
+
+enum class Counter {
+    ALLOCATIONS,          // выделения буферов
+    REALLOCATIONS,        // замены буфера Vector при росте, включая RawMemory::Reallocate; первое выделение не считается
+    DEALLOCATIONS,        // освобождения буферов
+    BYTES_ALLOCATED,
+    BYTES_FREED,
+    PEAK_BYTES_IN_USE,    // наибольшее значение разности выделенных и освобождённых байт
+    ELEMENTS_MOVED,       // элементы, перенесённые конструктором перемещения при росте
+    ELEMENTS_COPIED,      // элементы, скопированные при росте, так как перемещение может выбросить исключение
+    ELEMENTS_RELOCATED,   // элементы, перенесённые побайтово
+    ELEMENTS_SHIFTED,     // элементы, сдвинутые вставкой и удалением в середине
+    COUNT,
+};
+
+inline constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+
+inline constexpr const char* COUNTER_NAMES[COUNTER_COUNT] = {
+    "allocations",
+    "reallocations",
+    "deallocations",
+    "bytes_allocated",
+    "bytes_freed",
+    "peak_bytes_in_use",
+    "elements_moved",
+    "elements_copied",
+    "elements_relocated",
+    "elements_shifted",
+};
+
+// Значения счётчиков в момент снимка
+struct Snapshot {
+    uint64_t operator[](Counter counter) const noexcept {
+        return values[static_cast<size_t>(counter)];
+    }
+
+    uint64_t values[COUNTER_COUNT] = {};
+};
+
+// Потокобезопасный набор счётчиков
+class Counters {
+public:
+    void Add(Counter counter, uint64_t value) noexcept {
+        values_[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void UpdateMax(Counter counter, uint64_t value) noexcept {
+        std::atomic<uint64_t>& current = values_[static_cast<size_t>(counter)];
+        uint64_t old_value = current.load(std::memory_order_relaxed);
+        while (old_value < value && !current.compare_exchange_weak(old_value, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Учитывает изменение объёма занятой памяти и обновляет его пиковое значение.
+    // Объём может стать отрицательным, если освобождается память, выделенная до Reset или вне метки
+    void AddBytesInUse(int64_t delta) noexcept {
+        const int64_t in_use = bytes_in_use_.fetch_add(delta, std::memory_order_relaxed) + delta;
+        if (in_use > 0) {
+            UpdateMax(Counter::PEAK_BYTES_IN_USE, static_cast<uint64_t>(in_use));
+        }
+    }
+
+    Snapshot Load() const noexcept {
+        Snapshot snapshot;
+        for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+            snapshot.values[i] = values_[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    void Reset() noexcept {
+        for (auto& value : values_) {
+            value.store(0, std::memory_order_relaxed);
+        }
+        bytes_in_use_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> values_[COUNTER_COUNT] = {};
+    std::atomic<int64_t> bytes_in_use_{ 0 };
+};
+
+namespace detail {
+
+inline Counters& GlobalCounters() noexcept {
+    static Counters counters;
+    return counters;
+}
+
+struct TagRegistry {
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Counters>> counters;
+};
+
+inline TagRegistry& Tags() {
+    static TagRegistry registry;
+    return registry;
+}
+
+// Счётчики метки, активной в текущем потоке
+inline thread_local Counters* current_tag = nullptr;
+
+}  // namespace detail
+
+// Счётчики метки tag; создаются при первом обращении и живут до конца программы
+inline Counters& TagCounters(const std::string& tag) {
+    detail::TagRegistry& registry = detail::Tags();
+    std::lock_guard lock(registry.mutex);
+    std::unique_ptr<Counters>& counters = registry.counters[tag];
+    if (!counters) {
+        counters = std::make_unique<Counters>();
+    }
+    return *counters;
+}
+
+// Пока объект существует, события текущего потока дополнительно учитываются в счётчиках метки tag.
+// Области вкладываются: по завершении восстанавливается предыдущая метка
+class TagScope {
+public:
+    explicit TagScope(const std::string& tag)
+        : previous_(detail::current_tag)
+    {
+        detail::current_tag = &TagCounters(tag);
+    }
+
+    TagScope(const TagScope& other) = delete;
+
+    TagScope& operator= (const TagScope& other) = delete;
+
+    ~TagScope() {
+        detail::current_tag = previous_;
+    }
+
+private:
+    Counters* previous_;
+};
+
+// Пиковый объём занятой памяти выводится из событий BYTES_ALLOCATED и BYTES_FREED
+inline void Record(Counter counter, uint64_t value) noexcept {
+    const auto record = [counter, value](Counters& counters) {
+        counters.Add(counter, value);
+        if (counter == Counter::BYTES_ALLOCATED) {
+            counters.AddBytesInUse(static_cast<int64_t>(value));
+        }
+        else if (counter == Counter::BYTES_FREED) {
+            counters.AddBytesInUse(-static_cast<int64_t>(value));
+        }
+    };
+    record(detail::GlobalCounters());
+    if (detail::current_tag != nullptr) {
+        record(*detail::current_tag);
+    }
+}
+
+inline Snapshot GetSnapshot() noexcept {
+    return detail::GlobalCounters().Load();
+}
+
+inline std::map<std::string, Snapshot> GetTagSnapshots() {
+    detail::TagRegistry& registry = detail::Tags();
+    std::lock_guard lock(registry.mutex);
+    std::map<std::string, Snapshot> result;
+    for (const auto& [tag, counters] : registry.counters) {
+        result.emplace(tag, counters->Load());
+    }
+    return result;
+}
+
+// Обнуляет глобальные счётчики и счётчики всех меток
+inline void Reset() {
+    detail::GlobalCounters().Reset();
+    detail::TagRegistry& registry = detail::Tags();
+    std::lock_guard lock(registry.mutex);
+    for (auto& [tag, counters] : registry.counters) {
+        counters->Reset();
+    }
+}
+
+// Выводит счётчики в виде строк "<метка> <счётчик>=<значение> ...", глобальные — с меткой "*"
+inline void Dump(std::ostream& out) {
+    const auto dump_line = [&out](const std::string& tag, const Snapshot& snapshot) {
+        out << tag;
+        for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+            out << ' ' << COUNTER_NAMES[i] << '=' << snapshot.values[i];
+        }
+        out << '\n';
+    };
+    dump_line("*", GetSnapshot());
+    for (const auto& [tag, snapshot] : GetTagSnapshots()) {
+        dump_line(tag, snapshot);
+    }
+}
+
+}  // namespace instrumentation
+
+#if defined(VECTOR_INSTRUMENTATION)
+#define VECTOR_COUNT(COUNTER, VALUE) \
+    ::instrumentation::Record(::instrumentation::Counter::COUNTER, static_cast<uint64_t>(VALUE))
+#else
+#define VECTOR_COUNT(COUNTER, VALUE) ((void)0)
+#endif
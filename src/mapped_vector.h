@@ -0,0 +1,321 @@
+#pragma once
+
+#include "growth_policy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Вектор тривиально копируемых элементов, хранящий данные в файле через mmap.
+// Файл начинается с заголовка (магическое число, размер элемента, размер, вместимость), за которым
+// следуют элементы. Существующий файл открывается за O(1) без чтения и копирования данных.
+// Рост выполняется через ftruncate и переотображение файла
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector requires a trivially copyable type");
+
+public:
+    static constexpr uint64_t MAGIC = 0x524f544345564d4dull;  // "MMVECTOR"
+    static constexpr size_t DATA_OFFSET = 64;
+
+    static_assert(alignof(T) <= DATA_OFFSET, "MappedVector does not support types aligned beyond 64 bytes");
+
+// ---------- Iterator --------------------------------------------------------
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+
+    iterator end() noexcept {
+        return Data() + Size();
+    }
+
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+
+    const_iterator end() const noexcept {
+        return Data() + Size();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- MappedVector ----------------------------------------------------
+    MappedVector() = default;
+
+    MappedVector(const MappedVector& other) = delete;
+
+    MappedVector& operator= (const MappedVector& other) = delete;
+
+    MappedVector(MappedVector&& other) noexcept {
+        Exchange(other);
+    }
+
+    MappedVector& operator= (MappedVector&& other) noexcept {
+        if (this != &other) {
+            Close();
+            Exchange(other);
+        }
+        return *this;
+    }
+
+    ~MappedVector() {
+        Close();
+    }
+
+    // Создаёт новый файл (существующий перезаписывается) с вместимостью capacity элементов
+    static MappedVector Create(const std::string& path, size_t capacity = 0) {
+        CheckCapacity(capacity);
+        MappedVector result;
+        result.fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (result.fd_ < 0) {
+            ThrowSystemError("Cannot create " + path);
+        }
+        result.Truncate(capacity);
+        result.Map(MappedBytes(capacity));
+        *result.GetHeader() = Header{ MAGIC, sizeof(T), 0, capacity };
+        return result;
+    }
+
+    // Открывает существующий файл. В режиме только для чтения изменяющие методы выбрасывают std::logic_error
+    static MappedVector Open(const std::string& path, bool writable = false) {
+        MappedVector result;
+        result.read_only_ = !writable;
+        result.fd_ = open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+        if (result.fd_ < 0) {
+            ThrowSystemError("Cannot open " + path);
+        }
+        struct stat file_stat {};
+        if (fstat(result.fd_, &file_stat) != 0) {
+            ThrowSystemError("Cannot stat " + path);
+        }
+        const size_t file_size = static_cast<size_t>(file_stat.st_size);
+        if (file_size < DATA_OFFSET) {
+            throw std::runtime_error("Invalid MappedVector file " + path);
+        }
+        result.Map(file_size);
+
+        // Вместимость сравнивается с размером файла делением: MappedBytes(header.capacity) может переполниться
+        const Header& header = *result.GetHeader();
+        if (header.magic != MAGIC || header.element_size != sizeof(T) || header.size > header.capacity
+            || header.capacity > (file_size - DATA_OFFSET) / sizeof(T)) {
+            throw std::runtime_error("Invalid MappedVector file " + path);
+        }
+        return result;
+    }
+
+    size_t Size() const noexcept {
+        return IsOpen() ? GetHeader()->size : 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsOpen() ? GetHeader()->capacity : 0;
+    }
+
+    bool IsOpen() const noexcept {
+        return mapping_ != nullptr;
+    }
+
+    bool IsReadOnly() const noexcept {
+        return read_only_;
+    }
+
+    // В режиме только для чтения запись через неконстантные указатели приводит к ошибке защиты памяти
+    T* Data() noexcept {
+        return IsOpen() ? reinterpret_cast<T*>(mapping_ + DATA_OFFSET) : nullptr;
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<MappedVector&>(*this).Data();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<MappedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    void Reserve(size_t new_capacity) {
+        CheckWritable();
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        CheckCapacity(new_capacity);
+        Truncate(new_capacity);
+        Remap(MappedBytes(new_capacity));
+        GetHeader()->capacity = new_capacity;
+    }
+
+    void Resize(size_t new_size) {
+        CheckWritable();
+        const size_t size = Size();
+        if (new_size > size) {
+            Reserve(new_size);
+            std::uninitialized_value_construct_n(Data() + size, new_size - size);
+        }
+        GetHeader()->size = new_size;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        CheckWritable();
+        // Элемент создаётся до переотображения, так как аргументы могут ссылаться на элементы вектора
+        T value(std::forward<Args>(args)...);
+        const size_t size = Size();
+        if (size == Capacity()) {
+            Reserve(GrowthPolicy::template NextCapacity<T>(size, size + 1));
+        }
+        T* slot = new (Data() + size) T(value);
+        GetHeader()->size = size + 1;
+        return *slot;
+    }
+
+    void PopBack() {
+        CheckWritable();
+        assert(Size() != 0);
+        --GetHeader()->size;
+    }
+
+    void Clear() {
+        CheckWritable();
+        GetHeader()->size = 0;
+    }
+
+    // Синхронно сбрасывает изменения отображения в файл
+    void Flush() {
+        if (IsOpen() && !read_only_ && msync(mapping_, mapped_bytes_, MS_SYNC) != 0) {
+            ThrowSystemError("Cannot flush MappedVector");
+        }
+    }
+
+private:
+    struct Header {
+        uint64_t magic;
+        uint64_t element_size;
+        uint64_t size;
+        uint64_t capacity;
+    };
+
+    static_assert(sizeof(Header) <= DATA_OFFSET);
+
+    // Размер файла с capacity элементами должен помещаться в off_t, иначе MappedBytes переполнится
+    static void CheckCapacity(size_t capacity) {
+        constexpr auto MAX_FILE_SIZE = static_cast<uint64_t>(std::numeric_limits<off_t>::max());
+        if (capacity > (MAX_FILE_SIZE - DATA_OFFSET) / sizeof(T)) {
+            throw std::length_error("MappedVector capacity is too large");
+        }
+    }
+
+    static size_t MappedBytes(size_t capacity) noexcept {
+        return DATA_OFFSET + capacity * sizeof(T);
+    }
+
+    [[noreturn]] static void ThrowSystemError(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    Header* GetHeader() noexcept {
+        return reinterpret_cast<Header*>(mapping_);
+    }
+
+    const Header* GetHeader() const noexcept {
+        return reinterpret_cast<const Header*>(mapping_);
+    }
+
+    void CheckWritable() const {
+        if (!IsOpen() || read_only_) {
+            throw std::logic_error("MappedVector is not open for writing");
+        }
+    }
+
+    void Truncate(size_t capacity) {
+        if (ftruncate(fd_, static_cast<off_t>(MappedBytes(capacity))) != 0) {
+            ThrowSystemError("Cannot resize MappedVector file");
+        }
+    }
+
+    void Map(size_t bytes) {
+        mapping_ = MapFile(bytes);
+        mapped_bytes_ = bytes;
+    }
+
+    std::byte* MapFile(size_t bytes) const {
+        const int protection = read_only_ ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* mapping = mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            ThrowSystemError("Cannot map MappedVector file");
+        }
+        return static_cast<std::byte*>(mapping);
+    }
+
+    void Remap(size_t bytes) {
+#if defined(__linux__)
+        void* mapping = mremap(mapping_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+        if (mapping == MAP_FAILED) {
+            ThrowSystemError("Cannot remap MappedVector file");
+        }
+        mapping_ = static_cast<std::byte*>(mapping);
+        mapped_bytes_ = bytes;
+#else
+        // Новая область отображается до освобождения старой: при ошибке прежнее отображение сохраняется
+        std::byte* mapping = MapFile(bytes);
+        munmap(mapping_, mapped_bytes_);
+        mapping_ = mapping;
+        mapped_bytes_ = bytes;
+#endif
+    }
+
+    void Close() noexcept {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mapped_bytes_);
+            mapping_ = nullptr;
+            mapped_bytes_ = 0;
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    void Exchange(MappedVector& other) noexcept {
+        fd_ = std::exchange(other.fd_, -1);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+        read_only_ = std::exchange(other.read_only_, false);
+    }
+
+    int fd_ = -1;
+    std::byte* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    bool read_only_ = false;
+};
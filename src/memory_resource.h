@@ -0,0 +1,281 @@
+#pragma once
+
+#include "allocators.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+// Аллокатор в стиле стандартной библиотеки, передающий запросы ресурсу памяти std::pmr::memory_resource.
+// В отличие от std::pmr::polymorphic_allocator допускает присваивание и перемещается вместе с буфером,
+// поэтому Vector<T, ResourceAllocator<T>> сохраняет перемещение и обмен за O(1)
+template <typename T>
+class ResourceAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ResourceAllocator() noexcept
+        : resource_(std::pmr::get_default_resource()) {
+    }
+
+    ResourceAllocator(std::pmr::memory_resource* resource) noexcept
+        : resource_(resource) {
+    }
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U>& other) noexcept
+        : resource_(other.Resource()) {
+    }
+
+    T* allocate(size_t n) {
+        allocator_detail::CheckElementCount<T>(n);
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        resource_->deallocate(buf, n * sizeof(T), alignof(T));
+    }
+
+    size_t max_size() const noexcept {
+        return allocator_detail::MaxElements<T>();
+    }
+
+    std::pmr::memory_resource* Resource() const noexcept {
+        return resource_;
+    }
+
+    template <typename U>
+    bool operator==(const ResourceAllocator<U>& other) const noexcept {
+        return *resource_ == *other.Resource();
+    }
+
+    template <typename U>
+    bool operator!=(const ResourceAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    std::pmr::memory_resource* resource_;
+};
+
+// ----------------------------------------------------------------------------
+
+// Монотонный ресурс: выделяет память сдвигом указателя внутри крупных блоков, полученных от вышестоящего ресурса.
+// Освобождение отдельных фрагментов ничего не делает (кроме последнего выделенного), вся память
+// возвращается разом методом Release или в деструкторе. Не потокобезопасен
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit ArenaResource(size_t initial_block_size = DEFAULT_BLOCK_SIZE,
+                           std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream)
+        , initial_block_size_(std::max(initial_block_size, BLOCK_HEADER_SIZE * 2))
+        , next_block_size_(initial_block_size_) {
+    }
+
+    ArenaResource(const ArenaResource& other) = delete;
+
+    ArenaResource& operator= (const ArenaResource& other) = delete;
+
+    ~ArenaResource() override {
+        Release();
+    }
+
+    // Возвращает вышестоящему ресурсу все блоки, после чего арена снова готова к работе
+    void Release() noexcept {
+        while (blocks_ != nullptr) {
+            Block* prev = blocks_->prev;
+            upstream_->deallocate(blocks_, blocks_->size, alignof(std::max_align_t));
+            blocks_ = prev;
+        }
+        current_ = nullptr;
+        end_ = nullptr;
+        next_block_size_ = initial_block_size_;
+    }
+
+    std::pmr::memory_resource* Upstream() const noexcept {
+        return upstream_;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* result = Bump(bytes, alignment);
+        if (result == nullptr) {
+            AllocateBlock(bytes + alignment);
+            result = Bump(bytes, alignment);
+        }
+        return result;
+    }
+
+    void do_deallocate(void* buf, size_t bytes, size_t /*alignment*/) override {
+        // Последний выделенный фрагмент возвращается сразу, чтобы временные буферы не расходовали блок
+        std::byte* ptr = static_cast<std::byte*>(buf);
+        if (ptr + bytes == current_) {
+            current_ = ptr;
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct Block {
+        Block* prev;
+        size_t size;
+    };
+
+    static constexpr size_t BLOCK_HEADER_SIZE = (sizeof(Block) + alignof(std::max_align_t) - 1)
+        / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    void* Bump(size_t bytes, size_t alignment) noexcept {
+        if (current_ == nullptr) {
+            return nullptr;
+        }
+        void* ptr = current_;
+        size_t space = static_cast<size_t>(end_ - current_);
+        if (std::align(alignment, bytes, ptr, space) == nullptr) {
+            return nullptr;
+        }
+        current_ = static_cast<std::byte*>(ptr) + bytes;
+        return ptr;
+    }
+
+    void AllocateBlock(size_t min_size) {
+        size_t size = std::max(next_block_size_, min_size + BLOCK_HEADER_SIZE);
+        void* buf = upstream_->allocate(size, alignof(std::max_align_t));
+
+        blocks_ = new (buf) Block{ blocks_, size };
+        current_ = static_cast<std::byte*>(buf) + BLOCK_HEADER_SIZE;
+        end_ = static_cast<std::byte*>(buf) + size;
+        next_block_size_ = size * 2;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    size_t initial_block_size_;
+    size_t next_block_size_;
+    Block* blocks_ = nullptr;
+    std::byte* current_ = nullptr;
+    std::byte* end_ = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+
+// Пул с классами размеров: запросы до MAX_POOLED_SIZE байт округляются вверх до степени двойки
+// и обслуживаются из списков свободных фрагментов своего класса, более крупные запросы и запросы
+// с выравниванием больше alignof(std::max_align_t) передаются вышестоящему ресурсу. Не потокобезопасен
+class PoolResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t MIN_CLASS_SIZE = 8;
+    static constexpr size_t MAX_POOLED_SIZE = 4096;
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit PoolResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+                          size_t chunk_size = DEFAULT_CHUNK_SIZE)
+        : upstream_(upstream)
+        , chunk_size_((std::max(chunk_size, MAX_POOLED_SIZE) + MAX_POOLED_SIZE - 1) / MAX_POOLED_SIZE * MAX_POOLED_SIZE) {
+    }
+
+    PoolResource(const PoolResource& other) = delete;
+
+    PoolResource& operator= (const PoolResource& other) = delete;
+
+    ~PoolResource() override {
+        Release();
+    }
+
+    // Возвращает вышестоящему ресурсу все фрагменты пула, включая ещё не освобождённые
+    void Release() noexcept {
+        while (chunks_ != nullptr) {
+            Chunk* prev = chunks_->prev;
+            upstream_->deallocate(chunks_, chunks_->size, alignof(std::max_align_t));
+            chunks_ = prev;
+        }
+        std::fill(std::begin(free_lists_), std::end(free_lists_), nullptr);
+    }
+
+    std::pmr::memory_resource* Upstream() const noexcept {
+        return upstream_;
+    }
+
+    // Размер фрагмента, которым будет обслужен запрос на bytes байт
+    static size_t ClassSize(size_t bytes) noexcept {
+        return MIN_CLASS_SIZE << ClassIndex(bytes);
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        size_t size = std::max(bytes, alignment);
+        if (size > MAX_POOLED_SIZE || alignment > alignof(std::max_align_t)) {
+            return upstream_->allocate(bytes, alignment);
+        }
+        size_t index = ClassIndex(size);
+        if (free_lists_[index] == nullptr) {
+            Refill(index);
+        }
+        FreeNode* node = free_lists_[index];
+        free_lists_[index] = node->next;
+        return node;
+    }
+
+    void do_deallocate(void* buf, size_t bytes, size_t alignment) override {
+        size_t size = std::max(bytes, alignment);
+        if (size > MAX_POOLED_SIZE || alignment > alignof(std::max_align_t)) {
+            upstream_->deallocate(buf, bytes, alignment);
+            return;
+        }
+        size_t index = ClassIndex(size);
+        free_lists_[index] = new (buf) FreeNode{ free_lists_[index] };
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct Chunk {
+        Chunk* prev;
+        size_t size;
+    };
+
+    static constexpr size_t CLASS_COUNT = 10;
+    static constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + alignof(std::max_align_t) - 1)
+        / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    static_assert((MIN_CLASS_SIZE << (CLASS_COUNT - 1)) == MAX_POOLED_SIZE);
+
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t index = 0;
+        while ((MIN_CLASS_SIZE << index) < bytes) {
+            ++index;
+        }
+        return index;
+    }
+
+    // Нарезает новый фрагмент от вышестоящего ресурса на элементы класса index
+    void Refill(size_t index) {
+        size_t class_size = MIN_CLASS_SIZE << index;
+        size_t size = CHUNK_HEADER_SIZE + chunk_size_;
+        std::byte* buf = static_cast<std::byte*>(upstream_->allocate(size, alignof(std::max_align_t)));
+        chunks_ = new (buf) Chunk{ chunks_, size };
+
+        for (size_t offset = chunk_size_; offset >= class_size; offset -= class_size) {
+            free_lists_[index] = new (buf + CHUNK_HEADER_SIZE + offset - class_size) FreeNode{ free_lists_[index] };
+        }
+    }
+
+    std::pmr::memory_resource* upstream_;
+    size_t chunk_size_;
+    Chunk* chunks_ = nullptr;
+    FreeNode* free_lists_[CLASS_COUNT] = {};
+};
@@ -0,0 +1,641 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// Числовые ядра над Vector<T> и сырыми диапазонами T* для float, double, int32_t и int64_t:
+// сумма, скалярное произведение, минимум, максимум, индекс максимума, масштабирование, axpy,
+// поэлементные сложение и умножение. Реализации AVX2 и SSE4.2 выбираются во время выполнения по CPUID,
+// на остальных платформах используется скалярный вариант.
+// Порядок суммирования в векторных реализациях отличается от скалярного, поэтому результаты
+// для чисел с плавающей точкой могут расходиться в пределах погрешности округления
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_NUMERIC_X86 1
+#else
+#define VECTOR_NUMERIC_X86 0
+#endif
+
+namespace numeric {
+
+enum class Isa {
+    SCALAR,
+    SSE42,
+    AVX2,
+};
+
+template <typename T>
+inline constexpr bool IsKernelTypeV = std::is_same_v<T, float> || std::is_same_v<T, double>
+    || std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>;
+
+// Лучший набор инструкций, поддерживаемый процессором
+inline Isa DetectIsa() noexcept {
+#if VECTOR_NUMERIC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return Isa::SSE42;
+    }
+#endif
+    return Isa::SCALAR;
+}
+
+namespace detail {
+
+inline Isa& ActiveIsaRef() noexcept {
+    static Isa isa = DetectIsa();
+    return isa;
+}
+
+// ---------- Scalar ----------------------------------------------------------
+
+struct Scalar {
+    template <typename T>
+    static T Sum(const T* x, size_t n) noexcept {
+        T sum{};
+        for (size_t i = 0; i < n; ++i) {
+            sum += x[i];
+        }
+        return sum;
+    }
+
+    template <typename T>
+    static T Dot(const T* x, const T* y, size_t n) noexcept {
+        T sum{};
+        for (size_t i = 0; i < n; ++i) {
+            sum += x[i] * y[i];
+        }
+        return sum;
+    }
+
+    template <typename T>
+    static T Min(const T* x, size_t n) noexcept {
+        T result = x[0];
+        for (size_t i = 1; i < n; ++i) {
+            result = x[i] < result ? x[i] : result;
+        }
+        return result;
+    }
+
+    template <typename T>
+    static T Max(const T* x, size_t n) noexcept {
+        T result = x[0];
+        for (size_t i = 1; i < n; ++i) {
+            result = x[i] > result ? x[i] : result;
+        }
+        return result;
+    }
+
+    template <typename T>
+    static size_t ArgMax(const T* x, size_t n) noexcept {
+        size_t result = 0;
+        for (size_t i = 1; i < n; ++i) {
+            if (x[i] > x[result]) {
+                result = i;
+            }
+        }
+        return result;
+    }
+
+    template <typename T>
+    static void Scale(T* x, size_t n, T a) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            x[i] *= a;
+        }
+    }
+
+    template <typename T>
+    static void Axpy(T a, const T* x, T* y, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            y[i] += a * x[i];
+        }
+    }
+
+    template <typename T>
+    static void Add(const T* x, const T* y, T* out, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = x[i] + y[i];
+        }
+    }
+
+    template <typename T>
+    static void Mul(const T* x, const T* y, T* out, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = x[i] * y[i];
+        }
+    }
+};
+
+#if VECTOR_NUMERIC_X86
+
+// ---------- SIMD ------------------------------------------------------------
+
+// Ядра на векторных расширениях GCC шириной Bytes байт. Встраиваются в обёртки с атрибутом target,
+// поэтому один и тот же код компилируется в инструкции SSE4.2 и AVX2
+template <typename T, size_t Bytes>
+struct Kernels {
+    typedef T V __attribute__((vector_size(Bytes)));
+    using Index = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+    typedef Index VIndex __attribute__((vector_size(Bytes)));
+
+    static constexpr size_t LANES = Bytes / sizeof(T);
+
+    __attribute__((always_inline)) static inline void Load(V& v, const T* x) noexcept {
+        std::memcpy(&v, x, Bytes);
+    }
+
+    __attribute__((always_inline)) static inline void Store(T* x, const V& v) noexcept {
+        std::memcpy(x, &v, Bytes);
+    }
+
+    __attribute__((always_inline)) static inline T Sum(const T* x, size_t n) noexcept {
+        V acc0 = {};
+        V acc1 = {};
+        V v0;
+        V v1;
+        size_t i = 0;
+        for (; i + 2 * LANES <= n; i += 2 * LANES) {
+            Load(v0, x + i);
+            Load(v1, x + i + LANES);
+            acc0 += v0;
+            acc1 += v1;
+        }
+        acc0 += acc1;
+        T sum{};
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            sum += acc0[lane];
+        }
+        return sum + Scalar::Sum(x + i, n - i);
+    }
+
+    __attribute__((always_inline)) static inline T Dot(const T* x, const T* y, size_t n) noexcept {
+        V acc0 = {};
+        V acc1 = {};
+        V vx;
+        V vy;
+        size_t i = 0;
+        for (; i + 2 * LANES <= n; i += 2 * LANES) {
+            Load(vx, x + i);
+            Load(vy, y + i);
+            acc0 += vx * vy;
+            Load(vx, x + i + LANES);
+            Load(vy, y + i + LANES);
+            acc1 += vx * vy;
+        }
+        acc0 += acc1;
+        T sum{};
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            sum += acc0[lane];
+        }
+        return sum + Scalar::Dot(x + i, y + i, n - i);
+    }
+
+    __attribute__((always_inline)) static inline T Min(const T* x, size_t n) noexcept {
+        if (n < LANES) {
+            return Scalar::Min(x, n);
+        }
+        V best;
+        V v;
+        Load(best, x);
+        size_t i = LANES;
+        for (; i + LANES <= n; i += LANES) {
+            Load(v, x + i);
+            best = v < best ? v : best;
+        }
+        T result = best[0];
+        for (size_t lane = 1; lane < LANES; ++lane) {
+            result = best[lane] < result ? best[lane] : result;
+        }
+        return i < n ? std::min(result, Scalar::Min(x + i, n - i)) : result;
+    }
+
+    __attribute__((always_inline)) static inline T Max(const T* x, size_t n) noexcept {
+        if (n < LANES) {
+            return Scalar::Max(x, n);
+        }
+        V best;
+        V v;
+        Load(best, x);
+        size_t i = LANES;
+        for (; i + LANES <= n; i += LANES) {
+            Load(v, x + i);
+            best = v > best ? v : best;
+        }
+        T result = best[0];
+        for (size_t lane = 1; lane < LANES; ++lane) {
+            result = best[lane] > result ? best[lane] : result;
+        }
+        return i < n ? std::max(result, Scalar::Max(x + i, n - i)) : result;
+    }
+
+    // Каждая дорожка хранит свой максимум и его индекс; при равенстве выбирается наименьший индекс
+    __attribute__((always_inline)) static inline size_t ArgMax(const T* x, size_t n) noexcept {
+        if (n < LANES || n > static_cast<size_t>(std::numeric_limits<Index>::max())) {
+            return Scalar::ArgMax(x, n);
+        }
+        V best;
+        V v;
+        VIndex best_index;
+        VIndex index;
+        Load(best, x);
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            index[lane] = static_cast<Index>(lane);
+        }
+        best_index = index;
+        size_t i = LANES;
+        for (; i + LANES <= n; i += LANES) {
+            Load(v, x + i);
+            index += static_cast<Index>(LANES);
+            auto mask = v > best;
+            best = mask ? v : best;
+            best_index = mask ? index : best_index;
+        }
+        size_t result = static_cast<size_t>(best_index[0]);
+        T result_value = best[0];
+        for (size_t lane = 1; lane < LANES; ++lane) {
+            if (best[lane] > result_value
+                || (best[lane] == result_value && static_cast<size_t>(best_index[lane]) < result)) {
+                result = static_cast<size_t>(best_index[lane]);
+                result_value = best[lane];
+            }
+        }
+        for (; i < n; ++i) {
+            if (x[i] > result_value) {
+                result = i;
+                result_value = x[i];
+            }
+        }
+        return result;
+    }
+
+    __attribute__((always_inline)) static inline void Scale(T* x, size_t n, T a) noexcept {
+        V v;
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            Load(v, x + i);
+            v *= a;
+            Store(x + i, v);
+        }
+        Scalar::Scale(x + i, n - i, a);
+    }
+
+    __attribute__((always_inline)) static inline void Axpy(T a, const T* x, T* y, size_t n) noexcept {
+        V vx;
+        V vy;
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            Load(vx, x + i);
+            Load(vy, y + i);
+            vy += vx * a;
+            Store(y + i, vy);
+        }
+        Scalar::Axpy(a, x + i, y + i, n - i);
+    }
+
+    __attribute__((always_inline)) static inline void Add(const T* x, const T* y, T* out, size_t n) noexcept {
+        V vx;
+        V vy;
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            Load(vx, x + i);
+            Load(vy, y + i);
+            vx += vy;
+            Store(out + i, vx);
+        }
+        Scalar::Add(x + i, y + i, out + i, n - i);
+    }
+
+    __attribute__((always_inline)) static inline void Mul(const T* x, const T* y, T* out, size_t n) noexcept {
+        V vx;
+        V vy;
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            Load(vx, x + i);
+            Load(vy, y + i);
+            vx *= vy;
+            Store(out + i, vx);
+        }
+        Scalar::Mul(x + i, y + i, out + i, n - i);
+    }
+};
+
+// Обёртки, задающие набор инструкций, в который компилируются ядра
+#define VECTOR_NUMERIC_ISA(NAME, TARGET, BYTES)                                                 \
+    struct NAME {                                                                               \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static T Sum(const T* x, size_t n) noexcept {           \
+            return Kernels<T, BYTES>::Sum(x, n);                                                \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static T Dot(const T* x, const T* y, size_t n) noexcept { \
+            return Kernels<T, BYTES>::Dot(x, y, n);                                             \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static T Min(const T* x, size_t n) noexcept {           \
+            return Kernels<T, BYTES>::Min(x, n);                                                \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static T Max(const T* x, size_t n) noexcept {           \
+            return Kernels<T, BYTES>::Max(x, n);                                                \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static size_t ArgMax(const T* x, size_t n) noexcept {   \
+            return Kernels<T, BYTES>::ArgMax(x, n);                                             \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static void Scale(T* x, size_t n, T a) noexcept {       \
+            Kernels<T, BYTES>::Scale(x, n, a);                                                  \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static void Axpy(T a, const T* x, T* y, size_t n) noexcept { \
+            Kernels<T, BYTES>::Axpy(a, x, y, n);                                                \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static void Add(const T* x, const T* y, T* out, size_t n) noexcept { \
+            Kernels<T, BYTES>::Add(x, y, out, n);                                               \
+        }                                                                                       \
+        template <typename T>                                                                   \
+        __attribute__((target(TARGET))) static void Mul(const T* x, const T* y, T* out, size_t n) noexcept { \
+            Kernels<T, BYTES>::Mul(x, y, out, n);                                               \
+        }                                                                                       \
+    }
+
+VECTOR_NUMERIC_ISA(Sse42, "sse4.2", 16);
+VECTOR_NUMERIC_ISA(Avx2, "avx2", 32);
+
+#undef VECTOR_NUMERIC_ISA
+
+#define VECTOR_NUMERIC_DISPATCH(FUNC, ...)                  \
+    switch (ActiveIsa()) {                                  \
+    case Isa::AVX2:                                         \
+        return detail::Avx2::FUNC(__VA_ARGS__);             \
+    case Isa::SSE42:                                        \
+        return detail::Sse42::FUNC(__VA_ARGS__);            \
+    default:                                                \
+        return detail::Scalar::FUNC(__VA_ARGS__);           \
+    }
+
+#else
+
+#define VECTOR_NUMERIC_DISPATCH(FUNC, ...) return detail::Scalar::FUNC(__VA_ARGS__);
+
+#endif
+
+}  // namespace detail
+
+// Набор инструкций, которым выполняются ядра
+inline Isa ActiveIsa() noexcept {
+    return detail::ActiveIsaRef();
+}
+
+// Ограничивает набор инструкций (для тестов и измерений); неподдерживаемый набор понижается до доступного.
+// Не потокобезопасна
+inline void ForceIsa(Isa isa) noexcept {
+    detail::ActiveIsaRef() = std::min(isa, DetectIsa());
+}
+
+// ---------- Raw ranges ------------------------------------------------------
+
+template <typename T>
+T Sum(const T* x, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    VECTOR_NUMERIC_DISPATCH(Sum, x, n)
+}
+
+template <typename T>
+T Dot(const T* x, const T* y, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    VECTOR_NUMERIC_DISPATCH(Dot, x, y, n)
+}
+
+// Вызов для пустого диапазона приводит к неопределённому поведению
+template <typename T>
+T Min(const T* x, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    assert(n != 0);
+    VECTOR_NUMERIC_DISPATCH(Min, x, n)
+}
+
+template <typename T>
+T Max(const T* x, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    assert(n != 0);
+    VECTOR_NUMERIC_DISPATCH(Max, x, n)
+}
+
+// Индекс первого максимального элемента
+template <typename T>
+size_t ArgMax(const T* x, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    assert(n != 0);
+    VECTOR_NUMERIC_DISPATCH(ArgMax, x, n)
+}
+
+// x[i] *= a
+template <typename T>
+void Scale(T* x, size_t n, T a) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    VECTOR_NUMERIC_DISPATCH(Scale, x, n, a)
+}
+
+// y[i] += a * x[i]
+template <typename T>
+void Axpy(T a, const T* x, T* y, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    VECTOR_NUMERIC_DISPATCH(Axpy, a, x, y, n)
+}
+
+// out[i] = x[i] + y[i]; out может совпадать с x или y
+template <typename T>
+void Add(const T* x, const T* y, T* out, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    VECTOR_NUMERIC_DISPATCH(Add, x, y, out, n)
+}
+
+// out[i] = x[i] * y[i]; out может совпадать с x или y
+template <typename T>
+void Mul(const T* x, const T* y, T* out, size_t n) noexcept {
+    static_assert(IsKernelTypeV<T>);
+    VECTOR_NUMERIC_DISPATCH(Mul, x, y, out, n)
+}
+
+#undef VECTOR_NUMERIC_DISPATCH
+
+// ---------- Vector ----------------------------------------------------------
+// Константный вектор с IncrementalGrowth во время переноса не предоставляет Data(): его элементы
+// обрабатываются по непрерывным частям (Vector::VisitParts), без изменения вектора
+
+namespace detail {
+
+// Непустые непрерывные части элементов вектора; во время постепенного переноса их не больше трёх
+template <typename T>
+struct Parts {
+    const T* data[3] = {};
+    size_t size[3] = {};
+    size_t count = 0;
+};
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Parts<T> PartsOf(const Vector<T, Allocator, GrowthPolicy>& x) noexcept {
+    Parts<T> parts;
+    x.VisitParts([&parts](const T* data, size_t size) {
+        if (size != 0) {
+            parts.data[parts.count] = data;
+            parts.size[parts.count] = size;
+            ++parts.count;
+        }
+    });
+    return parts;
+}
+
+// Вызывает f(x_part, y_part, offset, count) для отрезков, непрерывных и в x, и в y
+template <typename T, typename Func>
+void ForZippedParts(const Parts<T>& x, const Parts<T>& y, Func f) noexcept {
+    size_t i = 0;
+    size_t j = 0;
+    size_t x_used = 0;
+    size_t y_used = 0;
+    size_t offset = 0;
+    while (i < x.count && j < y.count) {
+        const size_t count = std::min(x.size[i] - x_used, y.size[j] - y_used);
+        f(x.data[i] + x_used, y.data[j] + y_used, offset, count);
+        x_used += count;
+        y_used += count;
+        offset += count;
+        if (x_used == x.size[i]) {
+            ++i;
+            x_used = 0;
+        }
+        if (y_used == y.size[j]) {
+            ++j;
+            y_used = 0;
+        }
+    }
+}
+
+}  // namespace detail
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T Sum(const Vector<T, Allocator, GrowthPolicy>& x) noexcept {
+    if (!x.IsMigrating()) {
+        return Sum(x.Data(), x.Size());
+    }
+    const detail::Parts<T> parts = detail::PartsOf(x);
+    T total = Sum(parts.data[0], parts.size[0]);
+    for (size_t i = 1; i < parts.count; ++i) {
+        total += Sum(parts.data[i], parts.size[i]);
+    }
+    return total;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T Dot(const Vector<T, Allocator, GrowthPolicy>& x, const Vector<T, Allocator, GrowthPolicy>& y) noexcept {
+    assert(x.Size() == y.Size());
+    if (!x.IsMigrating() && !y.IsMigrating()) {
+        return Dot(x.Data(), y.Data(), x.Size());
+    }
+    T total{};
+    detail::ForZippedParts(detail::PartsOf(x), detail::PartsOf(y),
+        [&total](const T* x_part, const T* y_part, size_t /*offset*/, size_t count) {
+            total += Dot(x_part, y_part, count);
+        });
+    return total;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T Min(const Vector<T, Allocator, GrowthPolicy>& x) noexcept {
+    if (!x.IsMigrating()) {
+        return Min(x.Data(), x.Size());
+    }
+    const detail::Parts<T> parts = detail::PartsOf(x);
+    T result = Min(parts.data[0], parts.size[0]);
+    for (size_t i = 1; i < parts.count; ++i) {
+        result = std::min(result, Min(parts.data[i], parts.size[i]));
+    }
+    return result;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T Max(const Vector<T, Allocator, GrowthPolicy>& x) noexcept {
+    if (!x.IsMigrating()) {
+        return Max(x.Data(), x.Size());
+    }
+    const detail::Parts<T> parts = detail::PartsOf(x);
+    T result = Max(parts.data[0], parts.size[0]);
+    for (size_t i = 1; i < parts.count; ++i) {
+        result = std::max(result, Max(parts.data[i], parts.size[i]));
+    }
+    return result;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t ArgMax(const Vector<T, Allocator, GrowthPolicy>& x) noexcept {
+    if (!x.IsMigrating()) {
+        return ArgMax(x.Data(), x.Size());
+    }
+    const detail::Parts<T> parts = detail::PartsOf(x);
+    size_t result = ArgMax(parts.data[0], parts.size[0]);
+    T max_value = parts.data[0][result];
+    size_t offset = parts.size[0];
+    for (size_t i = 1; i < parts.count; ++i) {
+        const size_t index = ArgMax(parts.data[i], parts.size[i]);
+        // Строгое сравнение сохраняет индекс первого максимального элемента
+        if (max_value < parts.data[i][index]) {
+            max_value = parts.data[i][index];
+            result = offset + index;
+        }
+        offset += parts.size[i];
+    }
+    return result;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Scale(Vector<T, Allocator, GrowthPolicy>& x, T a) noexcept {
+    Scale(x.Data(), x.Size(), a);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Axpy(T a, const Vector<T, Allocator, GrowthPolicy>& x, Vector<T, Allocator, GrowthPolicy>& y) noexcept {
+    assert(x.Size() == y.Size());
+    T* out = y.Data();
+    x.VisitParts([a, &out](const T* x_part, size_t count) {
+        Axpy(a, x_part, out, count);
+        out += count;
+    });
+}
+
+// out[i] = x[i] + y[i]; размер out приводится к размеру x
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Add(const Vector<T, Allocator, GrowthPolicy>& x, const Vector<T, Allocator, GrowthPolicy>& y,
+         Vector<T, Allocator, GrowthPolicy>& out) {
+    assert(x.Size() == y.Size());
+    out.ResizeDefaultInit(x.Size());
+    T* result = out.Data();
+    detail::ForZippedParts(detail::PartsOf(x), detail::PartsOf(y),
+        [result](const T* x_part, const T* y_part, size_t offset, size_t count) {
+            Add(x_part, y_part, result + offset, count);
+        });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Mul(const Vector<T, Allocator, GrowthPolicy>& x, const Vector<T, Allocator, GrowthPolicy>& y,
+         Vector<T, Allocator, GrowthPolicy>& out) {
+    assert(x.Size() == y.Size());
+    out.ResizeDefaultInit(x.Size());
+    T* result = out.Data();
+    detail::ForZippedParts(detail::PartsOf(x), detail::PartsOf(y),
+        [result](const T* x_part, const T* y_part, size_t offset, size_t count) {
+            Mul(x_part, y_part, result + offset, count);
+        });
+}
+
+}  // namespace numeric
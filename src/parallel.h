@@ -0,0 +1,187 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<tbb/parallel_for.h>)
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#define VECTOR_PARALLEL_TBB 1
+#else
+#define VECTOR_PARALLEL_TBB 0
+#endif
+
+// Параллельные алгоритмы и параллельное создание элементов Vector на tbb::parallel_for.
+// Диапазоны короче PARALLEL_MIN_SIZE элементов и сборки без TBB обрабатываются в вызывающем потоке.
+// Создание элементов распараллеливается только для типов, конструкторы которых не выбрасывают исключений,
+// иначе выполняется последовательно со строгой гарантией. При параллельном создании страницы нового буфера
+// впервые затрагивают рабочие потоки, и в системах NUMA память размещается рядом с ними
+
+inline constexpr size_t PARALLEL_MIN_SIZE = 32 * 1024;
+inline constexpr size_t PARALLEL_GRAIN_SIZE = 4 * 1024;
+
+namespace parallel_detail {
+
+// Вызывает body(begin, end) для непересекающихся частей диапазона [0, count)
+template <typename Body>
+void ForChunks(size_t count, const Body& body) {
+    if (count == 0) {
+        return;
+    }
+#if VECTOR_PARALLEL_TBB
+    if (count >= PARALLEL_MIN_SIZE) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, count, PARALLEL_GRAIN_SIZE),
+            [&body](const tbb::blocked_range<size_t>& range) {
+                body(range.begin(), range.end());
+            });
+        return;
+    }
+#endif
+    body(size_t{ 0 }, count);
+}
+
+template <typename It>
+inline constexpr bool IsRandomAccessV = std::is_convertible_v<IteratorCategory<It>, std::random_access_iterator_tag>;
+
+}  // namespace parallel_detail
+
+// ---------- Algorithms ------------------------------------------------------
+
+// Вызывает f для каждого элемента; порядок вызовов не определён
+template <typename RandomIt, typename Func>
+void ParallelForEach(RandomIt first, RandomIt last, Func f) {
+    static_assert(parallel_detail::IsRandomAccessV<RandomIt>, "ParallelForEach requires random access iterators");
+    parallel_detail::ForChunks(static_cast<size_t>(last - first), [first, &f](size_t begin, size_t end) {
+        for (RandomIt it = first + begin; it != first + end; ++it) {
+            f(*it);
+        }
+    });
+}
+
+// Записывает f(*it) в out для каждого элемента [first, last); out может совпадать с first
+template <typename RandomIt, typename OutputIt, typename Func>
+OutputIt ParallelTransform(RandomIt first, RandomIt last, OutputIt out, Func f) {
+    static_assert(parallel_detail::IsRandomAccessV<RandomIt> && parallel_detail::IsRandomAccessV<OutputIt>,
+        "ParallelTransform requires random access iterators");
+    const size_t count = static_cast<size_t>(last - first);
+    parallel_detail::ForChunks(count, [first, out, &f](size_t begin, size_t end) {
+        OutputIt dest = out + begin;
+        for (RandomIt it = first + begin; it != first + end; ++it, ++dest) {
+            *dest = f(*it);
+        }
+    });
+    return out + count;
+}
+
+// Свёртка op(init, op(x0, op(x1, ...))) с произвольной расстановкой скобок: op должна быть ассоциативной,
+// коммутативность не требуется
+template <typename RandomIt, typename T, typename BinaryOp>
+T ParallelReduce(RandomIt first, RandomIt last, T init, BinaryOp op) {
+    static_assert(parallel_detail::IsRandomAccessV<RandomIt>, "ParallelReduce requires random access iterators");
+    const size_t count = static_cast<size_t>(last - first);
+    const auto fold = [first, &op](size_t begin, size_t end, std::optional<T> acc) {
+        for (RandomIt it = first + begin; it != first + end; ++it) {
+            acc = acc ? op(std::move(*acc), *it) : T(*it);
+        }
+        return acc;
+    };
+#if VECTOR_PARALLEL_TBB
+    if (count >= PARALLEL_MIN_SIZE) {
+        std::optional<T> result = tbb::parallel_reduce(
+            tbb::blocked_range<size_t>(0, count, PARALLEL_GRAIN_SIZE), std::optional<T>(),
+            [&fold](const tbb::blocked_range<size_t>& range, std::optional<T> acc) {
+                return fold(range.begin(), range.end(), std::move(acc));
+            },
+            [&op](std::optional<T> lhs, std::optional<T> rhs) {
+                if (!lhs || !rhs) {
+                    return lhs ? lhs : rhs;
+                }
+                return std::optional<T>(op(std::move(*lhs), std::move(*rhs)));
+            });
+        return result ? op(std::move(init), std::move(*result)) : init;
+    }
+#endif
+    std::optional<T> result = fold(0, count, std::nullopt);
+    return result ? op(std::move(init), std::move(*result)) : init;
+}
+
+// ---------- Construction ----------------------------------------------------
+
+// Аналог Vector::Resize: новые элементы инициализируются значением по умолчанию параллельно
+template <typename T, typename Allocator, typename GrowthPolicy>
+void ParallelResize(Vector<T, Allocator, GrowthPolicy>& v, size_t new_size) {
+    v.ResizeWith(new_size, [](T* first, size_t count) {
+        if constexpr (std::is_nothrow_default_constructible_v<T>) {
+            parallel_detail::ForChunks(count, [first](size_t begin, size_t end) {
+                std::uninitialized_value_construct(first + begin, first + end);
+            });
+        }
+        else {
+            std::uninitialized_value_construct_n(first, count);
+        }
+    });
+}
+
+// Аналог Vector::Resize, заполняющий новые элементы копиями value
+template <typename T, typename Allocator, typename GrowthPolicy>
+void ParallelResize(Vector<T, Allocator, GrowthPolicy>& v, size_t new_size, const T& value) {
+    // value может ссылаться на элемент вектора, который переместится при расширении буфера
+    const T fill_value(value);
+    v.ResizeWith(new_size, [&fill_value](T* first, size_t count) {
+        if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+            parallel_detail::ForChunks(count, [first, &fill_value](size_t begin, size_t end) {
+                std::uninitialized_fill(first + begin, first + end, fill_value);
+            });
+        }
+        else {
+            std::uninitialized_fill_n(first, count, fill_value);
+        }
+    });
+}
+
+// Аналог оператора присваивания: содержимое dst заменяется копиями элементов src.
+// Буфер dst переиспользуется, если его вместимости достаточно. При исключении dst остаётся пустым
+template <typename T, typename Allocator, typename GrowthPolicy>
+void ParallelAssign(Vector<T, Allocator, GrowthPolicy>& dst, const Vector<T, Allocator, GrowthPolicy>& src) {
+    if (&dst == &src) {
+        return;
+    }
+    dst.Clear();
+    // Источник копируется по непрерывным частям: src может быть в середине постепенного переноса
+    dst.ResizeWith(src.Size(), [&src](T* first, size_t /*count*/) {
+        T* out = first;
+        try {
+            src.VisitParts([&out](const T* source, size_t count) {
+                if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+                    parallel_detail::ForChunks(count, [source, out](size_t begin, size_t end) {
+                        std::uninitialized_copy(source + begin, source + end, out + begin);
+                    });
+                }
+                else {
+                    std::uninitialized_copy_n(source, count, out);
+                }
+                out += count;
+            });
+        }
+        catch (...) {
+            std::destroy(first, out);
+            throw;
+        }
+    });
+}
+
+// Аналог конструктора копирования
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy> ParallelCopy(const Vector<T, Allocator, GrowthPolicy>& src) {
+    Vector<T, Allocator, GrowthPolicy> result(
+        std::allocator_traits<Allocator>::select_on_container_copy_construction(src.GetAllocator()));
+    ParallelAssign(result, src);
+    return result;
+}
@@ -1,14 +1,57 @@
 #pragma once
 
+#include "instrumentation.h"
+
 #include <cassert>
+#include <cstddef>
+#include <memory>
 #include <new>
+#include <type_traits>
 #include <utility>
 
+// Признак того, что объект типа T можно перенести в другую область памяти побайтовым копированием,
+// не вызывая конструктор перемещения и деструктор исходного объекта.
+// Для тривиально копируемых типов определяется автоматически, для пользовательских типов
+// допускается явная специализация: template <> struct IsTriviallyRelocatable<MyType> : std::true_type {};
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {
+};
+
+template <typename T, typename Deleter>
+struct IsTriviallyRelocatable<std::unique_ptr<T, Deleter>> : IsTriviallyRelocatable<Deleter> {
+};
+
 template <typename T>
-class RawMemory {
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+// Признак аллокатора, умеющего изменять размер буфера без явного копирования: T* reallocate(T* buf, size_t old_n, size_t new_n)
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type {
+};
+
+template <typename Allocator>
+struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+    std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {
+};
+
+// Сырая память под элементы типа T, выделяемая аллокатором Allocator.
+// Аллокатор хранится как базовый класс, поэтому аллокаторы без состояния не увеличивают размер объекта
+template <typename T, typename Allocator = std::allocator<T>>
+class RawMemory : private Allocator {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
 public:
+    using allocator_type = Allocator;
+
+    // Можно ли менять вместимость методом Reallocate, перенося элементы побайтово
+    static constexpr bool CAN_REALLOCATE = IsTriviallyRelocatableV<T> && HasReallocate<Allocator>::value;
+
     RawMemory() = default;
 
+    explicit RawMemory(const Allocator& alloc)
+        : Allocator(alloc) {
+    }
+
     RawMemory(const RawMemory& other) = delete;
 
     RawMemory& operator= (const RawMemory& other) = delete;
@@ -22,17 +65,18 @@ public:
         return *this;
     }
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    explicit RawMemory(size_t capacity, const Allocator& alloc = Allocator())
+        : Allocator(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
     ~RawMemory() {
-        Deallocate(buffer_);
+        Deallocate(buffer_, capacity_);
     }
 
     T* operator+(size_t offset) noexcept {
-        //     ,     
+        // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
         assert(offset <= capacity_);
         return buffer_ + offset;
     }
@@ -51,6 +95,8 @@ public:
     }
 
     void Swap(RawMemory& other) noexcept {
+        using std::swap;
+        swap(static_cast<Allocator&>(*this), static_cast<Allocator&>(other));
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
@@ -67,9 +113,30 @@ public:
         return capacity_;
     }
 
+    const Allocator& GetAllocator() const noexcept {
+        return *this;
+    }
+
+    // Изменяет вместимость средствами аллокатора, сохраняя первые min(capacity, new_capacity) элементов.
+    // Буфер может быть расширен на месте; при исключении память остаётся прежней
+    void Reallocate(size_t new_capacity) {
+        static_assert(CAN_REALLOCATE, "Reallocate requires a trivially relocatable type and an allocator with reallocate");
+        if (buffer_ == nullptr || new_capacity == 0) {
+            RawMemory tmp(new_capacity, GetAllocator());
+            Swap(tmp);
+            return;
+        }
+        buffer_ = Allocator::reallocate(buffer_, capacity_, new_capacity);
+        VECTOR_COUNT(REALLOCATIONS, 1);
+        VECTOR_COUNT(BYTES_FREED, capacity_ * sizeof(T));
+        VECTOR_COUNT(BYTES_ALLOCATED, new_capacity * sizeof(T));
+        capacity_ = new_capacity;
+    }
+
 private:
     void Exchange(RawMemory&& other) {
-        Deallocate(buffer_);
+        Deallocate(buffer_, capacity_);
+        static_cast<Allocator&>(*this) = std::move(static_cast<Allocator&>(other));
 
         buffer_ = other.buffer_;
         capacity_ = other.capacity_;
@@ -78,14 +145,24 @@ private:
         other.capacity_ = 0;
     }
 
-    //     n      
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    // Выделяет сырую память под n элементов и возвращает указатель на неё
+    T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        T* buf = AllocatorTraits::allocate(*this, n);
+        VECTOR_COUNT(ALLOCATIONS, 1);
+        VECTOR_COUNT(BYTES_ALLOCATED, n * sizeof(T));
+        return buf;
     }
 
-    //   ,     buf   Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Освобождает сырую память под n элементов, выделенную ранее по адресу buf при помощи Allocate
+    void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            AllocatorTraits::deallocate(*this, buf, n);
+            VECTOR_COUNT(DEALLOCATIONS, 1);
+            VECTOR_COUNT(BYTES_FREED, n * sizeof(T));
+        }
     }
 
     T* buffer_ = nullptr;
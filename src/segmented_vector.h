@@ -0,0 +1,384 @@
+#pragma once
+
+#include "raw_memory.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Размер блока SegmentedVector по умолчанию: 16 КиБ, но не меньше 16 элементов
+template <typename T>
+inline constexpr size_t DEFAULT_SEGMENT_SIZE = std::max(size_t{ 16 }, 16 * 1024 / sizeof(T));
+
+// Вектор из блоков RawMemory<T, Allocator> фиксированного размера ChunkSize с индексом блоков.
+// Элементы никогда не переносятся: добавление в конец создаёт не больше одного нового блока,
+// поэтому не бывает пауз на перенос всех элементов, а ссылки и указатели на элементы остаются действительными.
+// При росте индекса перемещаются только описатели блоков (ChunkSize элементов на описатель)
+template <typename T, size_t ChunkSize = DEFAULT_SEGMENT_SIZE<T>, typename Allocator = std::allocator<T>>
+class SegmentedVector {
+    static_assert(ChunkSize > 0, "SegmentedVector requires non-empty chunks");
+
+    using Chunk = RawMemory<T, Allocator>;
+
+public:
+// ---------- Iterator --------------------------------------------------------
+    // Итератор произвольного доступа хранит индекс элемента и остаётся действительным при росте вектора
+    template <bool Const>
+    class BasicIterator {
+        using Owner = std::conditional_t<Const, const SegmentedVector, SegmentedVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator result = *this;
+            ++index_;
+            return result;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator result = *this;
+            --index_;
+            return result;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        friend class SegmentedVector;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- SegmentedVector -------------------------------------------------
+    static constexpr size_t CHUNK_SIZE = ChunkSize;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Allocator& alloc)
+        : alloc_(alloc)
+    {
+    }
+
+    explicit SegmentedVector(size_t size, const Allocator& alloc = Allocator())
+        : SegmentedVector(alloc)
+    {
+        Resize(size);
+    }
+
+    SegmentedVector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : SegmentedVector(alloc)
+    {
+        Reserve(init.size());
+        for (const T& value : init) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc_))
+    {
+        Reserve(other.size_);
+        for (const T& value : other) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , alloc_(other.alloc_)
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    SegmentedVector& operator= (const SegmentedVector& other) {
+        if (this != &other) {
+            SegmentedVector tmp(other);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator= (SegmentedVector&& other) noexcept {
+        if (this != &other) {
+            SegmentedVector tmp(std::move(other));
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkSize;
+    }
+
+    // Количество выделенных блоков
+    size_t ChunkCount() const noexcept {
+        return chunks_.Size();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return chunks_[index / ChunkSize][index % ChunkSize];
+    }
+
+    T& Back() noexcept {
+        assert(size_ != 0);
+        return (*this)[size_ - 1];
+    }
+
+    const T& Back() const noexcept {
+        return const_cast<SegmentedVector&>(*this).Back();
+    }
+
+    void Swap(SegmentedVector& other) noexcept {
+        using std::swap;
+        chunks_.Swap(other.chunks_);
+        swap(alloc_, other.alloc_);
+        std::swap(size_, other.size_);
+    }
+
+    // Выделяет блоки под new_capacity элементов; существующие элементы не перемещаются
+    void Reserve(size_t new_capacity) {
+        const size_t chunk_count = (new_capacity + ChunkSize - 1) / ChunkSize;
+        if (chunk_count <= chunks_.Size()) {
+            return;
+        }
+        chunks_.Reserve(chunk_count);
+        while (chunks_.Size() < chunk_count) {
+            chunks_.EmplaceBack(ChunkSize, alloc_);
+        }
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyTail(new_size);
+            return;
+        }
+        const size_t old_size = size_;
+        Reserve(new_size);
+        try {
+            while (size_ < new_size) {
+                EmplaceBack();
+            }
+        }
+        catch (...) {
+            DestroyTail(old_size);
+            throw;
+        }
+    }
+
+    // Уничтожает элементы; выделенные блоки сохраняются для повторного использования
+    void Clear() noexcept {
+        DestroyTail(0);
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(&Back());
+        --size_;
+    }
+
+    // Худший случай O(1) (не считая редкого роста индекса блоков): выделяется не больше одного блока
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            chunks_.EmplaceBack(ChunkSize, alloc_);
+        }
+        T* slot = chunks_[size_ / ChunkSize] + size_ % ChunkSize;
+        new (slot) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        if (pos < cbegin() || pos > cend()) {
+            throw std::range_error("Pos value is outside the SegmentedVector");
+        }
+        const size_t shift = pos.index_;
+        if (shift == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+        }
+        else {
+            T value(std::forward<Args>(args)...);
+            EmplaceBack(std::move(Back()));
+            std::move_backward(begin() + shift, end() - 2, end() - 1);
+            (*this)[shift] = std::move(value);
+        }
+        return begin() + shift;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    iterator Erase(const_iterator pos) {
+        if (pos < cbegin() || pos >= cend()) {
+            throw std::range_error("Pos value is outside the SegmentedVector");
+        }
+        const size_t shift = pos.index_;
+        std::move(begin() + shift + 1, end(), begin() + shift);
+        PopBack();
+        return begin() + shift;
+    }
+
+private:
+    void DestroyTail(size_t new_size) noexcept {
+        while (size_ > new_size) {
+            PopBack();
+        }
+    }
+
+    Vector<Chunk> chunks_;
+    Allocator alloc_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+// Неизменяемый снимок Vector с разделяемым хранилищем и копированием при записи.
+// Копирование SharedVector занимает O(1): увеличивается атомарный счётчик ссылок хранилища.
+// Первое изменение через дескриптор, хранилище которого разделено с другими, копирует элементы (O(n)),
+// после чего дескриптор владеет хранилищем единолично.
+// Разные дескрипторы одного хранилища можно копировать, читать и разрушать из разных потоков одновременно;
+// один и тот же дескриптор, как и Vector, нельзя изменять одновременно с другими обращениями к нему
+template <typename T, typename Allocator = std::allocator<T>>
+class SharedVector {
+    struct Storage {
+        explicit Storage(Vector<T, Allocator>&& vector) noexcept
+            : elements(std::move(vector))
+        {
+        }
+
+        Vector<T, Allocator> elements;
+        std::atomic<size_t> ref_count{ 1 };
+    };
+
+public:
+    using const_iterator = typename Vector<T, Allocator>::const_iterator;
+
+    const_iterator begin() const noexcept {
+        return storage_ != nullptr ? storage_->elements.begin() : nullptr;
+    }
+
+    const_iterator end() const noexcept {
+        return storage_ != nullptr ? storage_->elements.end() : nullptr;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- SharedVector ----------------------------------------------------
+    SharedVector() = default;
+
+    // Снимок без копирования элементов: хранилище забирается у vector
+    explicit SharedVector(Vector<T, Allocator>&& vector)
+        : storage_(new Storage(std::move(vector)))
+    {
+    }
+
+    explicit SharedVector(size_t size)
+        : SharedVector(Vector<T, Allocator>(size))
+    {
+    }
+
+    SharedVector(std::initializer_list<T> init)
+        : SharedVector(Vector<T, Allocator>(init))
+    {
+    }
+
+    SharedVector(const SharedVector& other) noexcept
+        : storage_(other.storage_)
+    {
+        if (storage_ != nullptr) {
+            storage_->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedVector(SharedVector&& other) noexcept
+        : storage_(std::exchange(other.storage_, nullptr))
+    {
+    }
+
+    SharedVector& operator= (const SharedVector& other) noexcept {
+        if (this != &other) {
+            SharedVector tmp(other);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    SharedVector& operator= (SharedVector&& other) noexcept {
+        if (this != &other) {
+            SharedVector tmp(std::move(other));
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    ~SharedVector() {
+        Release();
+    }
+
+    size_t Size() const noexcept {
+        return storage_ != nullptr ? storage_->elements.Size() : 0;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return storage_->elements[index];
+    }
+
+    const T* Data() const noexcept {
+        return begin();
+    }
+
+    // Элементы снимка только для чтения
+    const Vector<T, Allocator>& Get() const noexcept {
+        static const Vector<T, Allocator> empty;
+        return storage_ != nullptr ? storage_->elements : empty;
+    }
+
+    // Количество дескрипторов, разделяющих хранилище; 0 у пустого дескриптора
+    size_t UseCount() const noexcept {
+        return storage_ != nullptr ? storage_->ref_count.load(std::memory_order_acquire) : 0;
+    }
+
+    bool IsUnique() const noexcept {
+        return UseCount() == 1;
+    }
+
+    void Swap(SharedVector& other) noexcept {
+        std::swap(storage_, other.storage_);
+    }
+
+    // Изменяемые элементы. Разделённое хранилище сначала копируется (строгая гарантия безопасности исключений).
+    // Ссылка действительна, пока дескриптор не скопирован и не изменён
+    Vector<T, Allocator>& Mutable() {
+        if (storage_ == nullptr) {
+            storage_ = new Storage(Vector<T, Allocator>());
+        }
+        else if (!IsUnique()) {
+            Storage* copy = new Storage(Vector<T, Allocator>(storage_->elements));
+            Release();
+            storage_ = copy;
+        }
+        return storage_->elements;
+    }
+
+    // Забирает элементы: без копирования, если хранилище не разделено. Дескриптор становится пустым
+    Vector<T, Allocator> Take() {
+        Vector<T, Allocator> result = IsUnique() ? std::move(storage_->elements) : Vector<T, Allocator>(Get());
+        Release();
+        return result;
+    }
+
+    void PushBack(const T& value) {
+        Mutable().PushBack(value);
+    }
+
+    void PushBack(T&& value) {
+        Mutable().PushBack(std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return Mutable().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void PopBack() {
+        Mutable().PopBack();
+    }
+
+    void Resize(size_t new_size) {
+        Mutable().Resize(new_size);
+    }
+
+    // Отсоединяется от хранилища; остальные дескрипторы не меняются
+    void Clear() noexcept {
+        Release();
+    }
+
+private:
+    void Release() noexcept {
+        Storage* storage = std::exchange(storage_, nullptr);
+        // acq_rel: изменения, сделанные последним владельцем, видны потоку, разрушающему хранилище
+        if (storage != nullptr && storage->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete storage;
+        }
+    }
+
+    Storage* storage_ = nullptr;
+};
@@ -0,0 +1,302 @@
+#pragma once
+
+#include "raw_memory.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор, хранящий до N элементов во встроенном буфере без обращения к куче.
+// При переполнении элементы переносятся в RawMemory<T, Allocator>, дальше рост как у Vector
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
+class SmallVector {
+    static_assert(N > 0, "SmallVector requires a non-empty inline buffer");
+
+public:
+// ---------- Iterator --------------------------------------------------------
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+
+    iterator end() noexcept {
+        return Data() + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+
+    const_iterator end() const noexcept {
+        return Data() + size_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- SmallVector -----------------------------------------------------
+    SmallVector() = default;
+
+    explicit SmallVector(const Allocator& alloc)
+        : heap_(alloc)
+    {
+    }
+
+    explicit SmallVector(size_t size, const Allocator& alloc = Allocator())
+        : heap_(alloc)
+    {
+        Resize(size);
+    }
+
+    SmallVector(const SmallVector& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        StealFrom(other);
+    }
+
+    SmallVector& operator= (const SmallVector& other) {
+        if (this != &other) {
+            SmallVector tmp(other);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    SmallVector& operator= (SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            Clear();
+            StealFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        std::destroy_n(Data(), size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    // Находятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept {
+        return heap_.Capacity() == 0;
+    }
+
+    const Allocator& GetAllocator() const noexcept {
+        return heap_.GetAllocator();
+    }
+
+    T* Data() noexcept {
+        return IsInline() ? InlineData() : heap_.GetAddress();
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<SmallVector&>(*this).Data();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    void Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (!IsInline() && !other.IsInline()) {
+            heap_.Swap(other.heap_);
+            std::swap(size_, other.size_);
+            return;
+        }
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+
+        RawMemory<T, Allocator> new_data(new_capacity, heap_.GetAllocator());
+        UninitializedMoveOrCopy(Data(), size_, new_data.GetAddress());
+        DestroyIfNotRelocated(Data(), size_);
+
+        heap_.Swap(new_data);
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy_n(Data() + new_size, size_ - new_size);
+        }
+        else {
+            Reserve(new_size);
+            std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+    }
+
+    template <typename... Args>
+    void PushBack(Args&&... args) {
+        EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(Data() + size_ - 1);
+        --size_;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            return *GrowAndInsert(size_, std::forward<Args>(args)...);
+        }
+        new (Data() + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return Data()[size_ - 1];
+    }
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        if (pos < begin() || pos > end()) {
+            throw std::range_error("Pos value is outside the SmallVector");
+        }
+        size_t shift = pos - begin();
+
+        if (size_ == Capacity()) {
+            return GrowAndInsert(shift, std::forward<Args>(args)...);
+        }
+        T* data = Data();
+        if (shift == size_) {
+            new (data + size_) T(std::forward<Args>(args)...);
+        }
+        else {
+            T cp_value = T(std::forward<Args>(args)...);
+            new (data + size_) T(std::move(data[size_ - 1]));
+            std::move_backward(data + shift, data + size_ - 1, data + size_);
+            data[shift] = std::move(cp_value);
+        }
+        ++size_;
+        return data + shift;
+    }
+
+    iterator Erase(const_iterator pos) {
+        if (pos < begin() || pos >= end()) {
+            throw std::range_error("Pos value is outside the SmallVector");
+        }
+        size_t shift = pos - begin();
+        T* data = Data();
+        std::move(data + shift + 1, data + size_, data + shift);
+        std::destroy_at(data + size_ - 1);
+        --size_;
+        return data + shift;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+private:
+    T* InlineData() noexcept {
+        return reinterpret_cast<T*>(inline_data_);
+    }
+
+    // Забирает содержимое other в пустой вектор: буфер в куче передаётся целиком, встроенные элементы
+    // перемещаются поштучно. Аллокатор переходит от other, как при перемещении Vector, и у встроенного other
+    void StealFrom(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.IsInline()) {
+            std::uninitialized_move_n(other.InlineData(), other.size_, InlineData());
+            std::destroy_n(other.InlineData(), other.size_);
+        }
+        // Собственный буфер в куче освобождается; у встроенного other буфер пуст и передаётся только аллокатор
+        heap_ = std::move(other.heap_);
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    // Переносит элементы в новый буфер удвоенной вместимости и создаёт новый элемент в позиции shift.
+    // Новый элемент создаётся первым, так как аргументы могут ссылаться на элементы вектора
+    template <typename... Args>
+    T* GrowAndInsert(size_t shift, Args&&... args) {
+        RawMemory<T, Allocator> new_data(Capacity() * 2, heap_.GetAllocator());
+        new (new_data + shift) T(std::forward<Args>(args)...);
+        // --------------------------------------------------------------------
+        try {
+            UninitializedMoveOrCopy(Data(), shift, new_data.GetAddress());
+        }
+        catch (...) {
+            std::destroy_at(new_data + shift);
+            throw;
+        }
+        // --------------------------------------------------------------------
+        try {
+            UninitializedMoveOrCopy(Data() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
+        }
+        catch (...) {
+            std::destroy_n(new_data.GetAddress(), shift + 1);
+            throw;
+        }
+        // --------------------------------------------------------------------
+        DestroyIfNotRelocated(Data(), size_);
+        heap_.Swap(new_data);
+        ++size_;
+        return heap_.GetAddress() + shift;
+    }
+
+    // Для тривиально перемещаемых типов элементы копируются побайтово, исходные после этого не разрушаются
+    static void UninitializedMoveOrCopy(T* buff_from, size_t dist, T* buff_to) {
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            if (dist != 0) {
+                std::memcpy(static_cast<void*>(buff_to), static_cast<const void*>(buff_from), dist * sizeof(T));
+            }
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(buff_from, dist, buff_to);
+        }
+        else {
+            std::uninitialized_copy_n(buff_from, dist, buff_to);
+        }
+    }
+
+    static void DestroyIfNotRelocated(T* buff, size_t dist) noexcept {
+        if constexpr (!IsTriviallyRelocatableV<T>) {
+            std::destroy_n(buff, dist);
+        }
+    }
+
+    RawMemory<T, Allocator> heap_;
+    alignas(T) std::byte inline_data_[N * sizeof(T)];
+    size_t size_ = 0;
+};
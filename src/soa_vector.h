@@ -0,0 +1,467 @@
+#pragma once
+
+#include "raw_memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Непрерывный участок элементов одного столбца SoaVector
+template <typename T>
+class Span {
+public:
+    Span() = default;
+
+    Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    T* begin() const noexcept {
+        return data_;
+    }
+
+    T* end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Вектор записей, хранящий каждое поле в отдельном столбце RawMemory<T> (структура массивов).
+// Циклы, читающие одно-два поля, загружают из памяти только нужные столбцы.
+// Все столбцы имеют общие размер и вместимость и перераспределяются вместе со строгой гарантией безопасности исключений
+template <typename... Ts>
+class SoaVector {
+    static_assert(sizeof...(Ts) > 0, "SoaVector requires at least one column");
+
+    static constexpr size_t COLUMNS = sizeof...(Ts);
+
+    template <size_t I>
+    using ColumnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    using Columns = std::tuple<RawMemory<Ts>...>;
+
+    // Перенос не выбрасывает исключений ни в одном столбце, поэтому столбцы можно перемещать.
+    // Иначе перемещённые до исключения столбцы нельзя было бы восстановить, и все столбцы копируются
+    static constexpr bool NOTHROW_TRANSFER = ((IsTriviallyRelocatableV<Ts> || std::is_nothrow_move_constructible_v<Ts>) && ...);
+
+public:
+// ---------- Iterator --------------------------------------------------------
+    // Итератор по строкам; разыменование возвращает кортеж ссылок на поля строки.
+    // Поддерживает арифметику произвольного доступа, но, как любой прокси-итератор, объявлен итератором ввода
+    template <bool Const>
+    class BasicIterator {
+        using Owner = std::conditional_t<Const, const SoaVector, SoaVector>;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::tuple<Ts...>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>;
+        using pointer = void;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator result = *this;
+            ++index_;
+            return result;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+    private:
+        friend class SoaVector;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- SoaVector -------------------------------------------------------
+    SoaVector() = default;
+
+    explicit SoaVector(size_t size) {
+        Resize(size);
+    }
+
+    SoaVector(const SoaVector& other)
+        : columns_(MakeColumns(other.size_))
+    {
+        ForEachColumnWithRollback(
+            [this, &other](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                std::uninitialized_copy_n(other.template ColumnData<I>(), other.size_, ColumnData<I>());
+            },
+            [this, &other](auto column) {
+                std::destroy_n(ColumnData<decltype(column)::value>(), other.size_);
+            });
+        size_ = other.size_;
+    }
+
+    SoaVector(SoaVector&& other) noexcept {
+        Swap(other);
+    }
+
+    SoaVector& operator= (const SoaVector& other) {
+        if (this != &other) {
+            SoaVector tmp(other);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    SoaVector& operator= (SoaVector&& other) noexcept {
+        if (this != &other) {
+            SoaVector tmp(std::move(other));
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    ~SoaVector() {
+        Clear();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    // Кортеж ссылок на поля строки index
+    std::tuple<Ts&...> operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Row(index, std::index_sequence_for<Ts...>());
+    }
+
+    std::tuple<const Ts&...> operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return const_cast<SoaVector&>(*this).Row(index, std::index_sequence_for<Ts...>());
+    }
+
+    // Поле I строки index
+    template <size_t I>
+    ColumnType<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return ColumnData<I>()[index];
+    }
+
+    template <size_t I>
+    const ColumnType<I>& Get(size_t index) const noexcept {
+        return const_cast<SoaVector&>(*this).template Get<I>(index);
+    }
+
+    // Столбец I целиком: непрерывный массив, пригодный для векторных ядер
+    template <size_t I>
+    Span<ColumnType<I>> Column() noexcept {
+        return Span<ColumnType<I>>(ColumnData<I>(), size_);
+    }
+
+    template <size_t I>
+    Span<const ColumnType<I>> Column() const noexcept {
+        return Span<const ColumnType<I>>(const_cast<SoaVector&>(*this).template ColumnData<I>(), size_);
+    }
+
+    void Swap(SoaVector& other) noexcept {
+        ForEachColumn([this, &other](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            std::get<I>(columns_).Swap(std::get<I>(other.columns_));
+        });
+        std::swap(size_, other.size_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        Columns new_columns = MakeColumns(new_capacity);
+        TransferTo(new_columns);
+        ReplaceColumns(new_columns);
+    }
+
+    // Новые строки инициализируются значениями по умолчанию
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRows(new_size, size_);
+            size_ = new_size;
+            return;
+        }
+        Reserve(new_size);
+        ForEachColumnWithRollback(
+            [this, new_size](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                std::uninitialized_value_construct_n(ColumnData<I>() + size_, new_size - size_);
+            },
+            [this, new_size](auto column) {
+                std::destroy_n(ColumnData<decltype(column)::value>() + size_, new_size - size_);
+            });
+        size_ = new_size;
+    }
+
+    void Clear() noexcept {
+        DestroyRows(0, size_);
+        size_ = 0;
+    }
+
+    // Добавляет строку; аргумент I создаёт поле I
+    template <typename... Args>
+    void EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == COLUMNS, "EmplaceBack requires one argument per column");
+        auto values = std::forward_as_tuple(std::forward<Args>(args)...);
+        if (size_ == Capacity()) {
+            // Строка создаётся в новых столбцах до переноса, так как аргументы могут ссылаться на элементы вектора
+            Columns new_columns = MakeColumns(std::max(Capacity() * 2, size_t{ 1 }));
+            ConstructRow(new_columns, size_, values);
+            try {
+                TransferTo(new_columns);
+            }
+            catch (...) {
+                DestroyRow(new_columns, size_);
+                throw;
+            }
+            ReplaceColumns(new_columns);
+        }
+        else {
+            ConstructRow(columns_, size_, values);
+        }
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        DestroyRows(size_ - 1, size_);
+        --size_;
+    }
+
+    // Удаляет строку pos, сдвигая последующие строки в каждом столбце
+    iterator Erase(const_iterator pos) {
+        if (pos < cbegin() || !(pos < cend())) {
+            throw std::range_error("Pos value is outside the SoaVector");
+        }
+        const size_t shift = pos.index_;
+        ForEachColumn([this, shift](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            ColumnType<I>* data = ColumnData<I>();
+            std::move(data + shift + 1, data + size_, data + shift);
+        });
+        PopBack();
+        return begin() + shift;
+    }
+
+private:
+    template <size_t I>
+    ColumnType<I>* ColumnData() noexcept {
+        return std::get<I>(columns_).GetAddress();
+    }
+
+    template <size_t I>
+    const ColumnType<I>* ColumnData() const noexcept {
+        return std::get<I>(columns_).GetAddress();
+    }
+
+    template <size_t... Is>
+    std::tuple<Ts&...> Row(size_t index, std::index_sequence<Is...>) noexcept {
+        return std::tuple<Ts&...>(ColumnData<Is>()[index]...);
+    }
+
+    static Columns MakeColumns(size_t capacity) {
+        return Columns(RawMemory<Ts>(capacity)...);
+    }
+
+    // Вызывает op(std::integral_constant<size_t, I>) для каждого столбца
+    template <typename Op, size_t I = 0>
+    static void ForEachColumn(const Op& op) {
+        if constexpr (I < COLUMNS) {
+            op(std::integral_constant<size_t, I>());
+            ForEachColumn<Op, I + 1>(op);
+        }
+    }
+
+    // Как ForEachColumn, но при исключении вызывает undo для уже обработанных столбцов в обратном порядке
+    template <typename Op, typename Undo, size_t I = 0>
+    static void ForEachColumnWithRollback(const Op& op, const Undo& undo) {
+        if constexpr (I < COLUMNS) {
+            op(std::integral_constant<size_t, I>());
+            try {
+                ForEachColumnWithRollback<Op, Undo, I + 1>(op, undo);
+            }
+            catch (...) {
+                undo(std::integral_constant<size_t, I>());
+                throw;
+            }
+        }
+    }
+
+    template <typename Values>
+    static void ConstructRow(Columns& columns, size_t index, Values& values) {
+        ForEachColumnWithRollback(
+            [&columns, index, &values](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                using Arg = std::tuple_element_t<I, Values>;
+                new (std::get<I>(columns) + index) ColumnType<I>(std::forward<Arg>(std::get<I>(values)));
+            },
+            [&columns, index](auto column) {
+                std::destroy_at(std::get<decltype(column)::value>(columns) + index);
+            });
+    }
+
+    static void DestroyRow(Columns& columns, size_t index) noexcept {
+        ForEachColumn([&columns, index](auto column) {
+            std::destroy_at(std::get<decltype(column)::value>(columns) + index);
+        });
+    }
+
+    void DestroyRows(size_t first, size_t last) noexcept {
+        ForEachColumn([this, first, last](auto column) {
+            std::destroy(ColumnData<decltype(column)::value>() + first, ColumnData<decltype(column)::value>() + last);
+        });
+    }
+
+    // Переносит элементы всех столбцов в new_columns. Тривиально перемещаемые столбцы копируются побайтово,
+    // остальные перемещаются, если перенос всех столбцов не выбрасывает исключений, иначе копируются.
+    // При исключении созданные в new_columns элементы разрушаются, а исходные столбцы не меняются
+    void TransferTo(Columns& new_columns) {
+        ForEachColumnWithRollback(
+            [this, &new_columns](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                using T = ColumnType<I>;
+                T* buff_from = ColumnData<I>();
+                T* buff_to = std::get<I>(new_columns).GetAddress();
+                if constexpr (IsTriviallyRelocatableV<T>) {
+                    if (size_ != 0) {
+                        std::memcpy(static_cast<void*>(buff_to), static_cast<const void*>(buff_from), size_ * sizeof(T));
+                    }
+                }
+                else if constexpr (NOTHROW_TRANSFER || !std::is_copy_constructible_v<T>) {
+                    std::uninitialized_move_n(buff_from, size_, buff_to);
+                }
+                else {
+                    std::uninitialized_copy_n(buff_from, size_, buff_to);
+                }
+            },
+            [this, &new_columns](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                if constexpr (!IsTriviallyRelocatableV<ColumnType<I>>) {
+                    std::destroy_n(std::get<I>(new_columns).GetAddress(), size_);
+                }
+            });
+    }
+
+    // Разрушает исходные элементы (кроме побайтово перенесённых) и устанавливает новые столбцы
+    void ReplaceColumns(Columns& new_columns) noexcept {
+        ForEachColumn([this, &new_columns](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            if constexpr (!IsTriviallyRelocatableV<ColumnType<I>>) {
+                std::destroy_n(ColumnData<I>(), size_);
+            }
+            std::get<I>(columns_).Swap(std::get<I>(new_columns));
+        });
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+};
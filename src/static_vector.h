@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Поведение StaticVector при попытке превысить вместимость N
+enum class StaticOverflow {
+    THROW,   // исключение std::length_error, контейнер не меняется
+    ASSERT,  // проверка через assert; при NDEBUG проверки нет и переполнение - неопределённое поведение
+};
+
+namespace static_detail {
+
+// Встроенный буфер на N элементов и размер. Для тривиально копируемых T копирование, перемещение и разрушение
+// тривиальны (копируется весь буфер), поэтому тривиально копируемым остаётся и StaticVector
+template <typename T, size_t N, bool Trivial = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>>
+struct StaticStorage {
+    T* Data() noexcept {
+        return std::launder(reinterpret_cast<T*>(bytes));
+    }
+
+    const T* Data() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(bytes));
+    }
+
+    alignas(T) std::byte bytes[N * sizeof(T)];
+    size_t size = 0;
+};
+
+template <typename T, size_t N>
+struct StaticStorage<T, N, false> {
+    StaticStorage() = default;
+
+    StaticStorage(const StaticStorage& other) {
+        std::uninitialized_copy_n(other.Data(), other.size, Data());
+        size = other.size;
+    }
+
+    // Элементы перемещаются поштучно, other становится пустым
+    StaticStorage(StaticStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        std::uninitialized_move_n(other.Data(), other.size, Data());
+        size = other.size;
+        other.Clear();
+    }
+
+    // Общая часть присваивается, остаток создаётся или разрушается; буфер на N элементов не копируется целиком
+    StaticStorage& operator= (const StaticStorage& other) {
+        if (this != &other) {
+            Assign(other.Data(), other.size, [](const T& value) -> const T& { return value; });
+        }
+        return *this;
+    }
+
+    StaticStorage& operator= (StaticStorage&& other) noexcept(std::is_nothrow_move_assignable_v<T>
+        && std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other) {
+            Assign(other.Data(), other.size, [](T& value) -> T&& { return std::move(value); });
+            other.Clear();
+        }
+        return *this;
+    }
+
+    ~StaticStorage() {
+        Clear();
+    }
+
+    T* Data() noexcept {
+        return std::launder(reinterpret_cast<T*>(bytes));
+    }
+
+    const T* Data() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(bytes));
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(Data(), size);
+        size = 0;
+    }
+
+    template <typename U, typename Cast>
+    void Assign(U* from, size_t count, Cast cast) {
+        const size_t common = std::min(size, count);
+        for (size_t i = 0; i < common; ++i) {
+            Data()[i] = cast(from[i]);
+        }
+        if (count < size) {
+            std::destroy_n(Data() + count, size - count);
+            size = count;
+        }
+        for (; size < count; ++size) {
+            new (Data() + size) T(cast(from[size]));
+        }
+    }
+
+    alignas(T) std::byte bytes[N * sizeof(T)];
+    size_t size = 0;
+};
+
+}  // namespace static_detail
+
+// Вектор фиксированной вместимости N с элементами внутри объекта: память в куче не выделяется никогда.
+// Переполнение обрабатывается по политике Overflow; TryPushBack и TryEmplaceBack сообщают о нём без исключений
+template <typename T, size_t N, StaticOverflow Overflow = StaticOverflow::THROW>
+class StaticVector {
+    static_assert(N > 0, "StaticVector requires a non-empty buffer");
+
+public:
+// ---------- Iterator --------------------------------------------------------
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+
+    iterator end() noexcept {
+        return Data() + Size();
+    }
+
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+
+    const_iterator end() const noexcept {
+        return Data() + Size();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+public:
+// ---------- StaticVector ----------------------------------------------------
+    // Копирование, перемещение и разрушение определяет хранилище: для тривиально копируемых T они тривиальны
+    StaticVector() = default;
+
+    explicit StaticVector(size_t size) {
+        Resize(size);
+    }
+
+    StaticVector(std::initializer_list<T> init)
+        : StaticVector(init.begin(), init.end())
+    {
+    }
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    StaticVector(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+    }
+
+    size_t Size() const noexcept {
+        return storage_.size;
+    }
+
+    static constexpr size_t Capacity() noexcept {
+        return N;
+    }
+
+    T* Data() noexcept {
+        return storage_.Data();
+    }
+
+    const T* Data() const noexcept {
+        return storage_.Data();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<StaticVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    // Поэлементный обмен: O(max(Size(), other.Size()))
+    void Swap(StaticVector& other) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+        StaticVector* shorter = Size() < other.Size() ? this : &other;
+        StaticVector* longer = shorter == this ? &other : this;
+        const size_t common = shorter->Size();
+        std::swap_ranges(Data(), Data() + common, other.Data());
+        std::uninitialized_move(longer->Data() + common, longer->end(), shorter->Data() + common);
+        std::destroy(longer->Data() + common, longer->end());
+        std::swap(storage_.size, other.storage_.size);
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < Size()) {
+            std::destroy_n(Data() + new_size, Size() - new_size);
+        }
+        else {
+            CheckCapacity(new_size);
+            std::uninitialized_value_construct_n(Data() + Size(), new_size - Size());
+        }
+        storage_.size = new_size;
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(Data(), Size());
+        storage_.size = 0;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        CheckCapacity(Size() + 1);
+        return *Construct(std::forward<Args>(args)...);
+    }
+
+    // Добавление без исключения при переполнении: false, если контейнер заполнен
+    bool TryPushBack(const T& value) {
+        return TryEmplaceBack(value) != nullptr;
+    }
+
+    bool TryPushBack(T&& value) {
+        return TryEmplaceBack(std::move(value)) != nullptr;
+    }
+
+    // Указатель на созданный элемент или nullptr, если контейнер заполнен
+    template <typename... Args>
+    T* TryEmplaceBack(Args&&... args) {
+        return Size() < N ? Construct(std::forward<Args>(args)...) : nullptr;
+    }
+
+    void PopBack() noexcept {
+        assert(Size() != 0);
+        std::destroy_at(Data() + Size() - 1);
+        --storage_.size;
+    }
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        if (pos < begin() || pos > end()) {
+            throw std::range_error("Pos value is outside the StaticVector");
+        }
+        CheckCapacity(Size() + 1);
+        const size_t shift = pos - begin();
+        T* data = Data();
+        if (shift == Size()) {
+            Construct(std::forward<Args>(args)...);
+        }
+        else {
+            // Аргументы могут ссылаться на элементы вектора, поэтому значение создаётся до сдвига
+            T cp_value = T(std::forward<Args>(args)...);
+            new (data + Size()) T(std::move(data[Size() - 1]));
+            ++storage_.size;
+            std::move_backward(data + shift, data + Size() - 2, data + Size() - 1);
+            data[shift] = std::move(cp_value);
+        }
+        return data + shift;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    iterator Erase(const_iterator pos) {
+        if (pos < begin() || pos >= end()) {
+            throw std::range_error("Pos value is outside the StaticVector");
+        }
+        return Erase(pos, pos + 1);
+    }
+
+    iterator Erase(const_iterator first, const_iterator last) {
+        if (first < begin() || first > last || last > end()) {
+            throw std::range_error("Pos value is outside the StaticVector");
+        }
+        T* data = Data();
+        const size_t shift = first - begin();
+        const size_t count = last - first;
+        std::move(data + shift + count, data + Size(), data + shift);
+        std::destroy_n(data + Size() - count, count);
+        storage_.size -= count;
+        return data + shift;
+    }
+
+private:
+    void CheckCapacity(size_t required) const {
+        if constexpr (Overflow == StaticOverflow::THROW) {
+            if (required > N) {
+                throw std::length_error("StaticVector capacity exceeded");
+            }
+        }
+        else {
+            assert(required <= N);
+        }
+    }
+
+    template <typename... Args>
+    T* Construct(Args&&... args) {
+        T* element = new (Data() + Size()) T(std::forward<Args>(args)...);
+        ++storage_.size;
+        return element;
+    }
+
+    static_detail::StaticStorage<T, N> storage_;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Копирование больших буферов потоковыми (non-temporal) записями: данные пишутся в память в обход кэша,
+// поэтому копия размером больше кэша последнего уровня не вытесняет из него рабочие данные других потоков.
+// На x86 используются записи AVX (если процессор их поддерживает, проверка по CPUID во время выполнения) или SSE2,
+// на остальных платформах — обычный memcpy
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_STREAMING_X86 1
+#include <immintrin.h>
+#else
+#define VECTOR_STREAMING_X86 0
+#endif
+
+// Размер копии, начиная с которого StreamingHint::AUTO выбирает потоковые записи: копия заведомо
+// не помещается в кэш второго уровня и заметную часть кэша последнего уровня
+inline constexpr size_t STREAMING_COPY_THRESHOLD = 4 * 1024 * 1024;
+
+enum class StreamingHint {
+    AUTO,    // потоковые записи для копий от STREAMING_COPY_THRESHOLD байт
+    ALWAYS,  // потоковые записи при любом размере
+    NEVER,   // обычное копирование через кэш
+};
+
+namespace streaming_detail {
+
+#if VECTOR_STREAMING_X86
+inline bool HasAvx() noexcept {
+    static const bool has_avx = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") != 0;
+    }();
+    return has_avx;
+}
+
+// Копируют bytes байт (кратное ширине регистра) в выровненный по ширине регистра dst
+__attribute__((target("avx"))) inline void StreamAvx(char* dst, const char* src, size_t bytes) noexcept {
+    for (size_t offset = 0; offset < bytes; offset += 32) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + offset),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + offset)));
+    }
+}
+
+__attribute__((target("sse2"))) inline void StreamSse2(char* dst, const char* src, size_t bytes) noexcept {
+    for (size_t offset = 0; offset < bytes; offset += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + offset),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset)));
+    }
+}
+#endif
+
+}  // namespace streaming_detail
+
+// Доступны ли потоковые записи; иначе StreamingCopy сводится к memcpy
+inline bool IsStreamingCopySupported() noexcept {
+    return VECTOR_STREAMING_X86 != 0;
+}
+
+// Выбирает потоковые записи для копии размером bytes
+inline bool UseStreamingCopy(size_t bytes, StreamingHint hint) noexcept {
+    switch (hint) {
+    case StreamingHint::ALWAYS:
+        return IsStreamingCopySupported();
+    case StreamingHint::NEVER:
+        return false;
+    default:
+        return IsStreamingCopySupported() && bytes >= STREAMING_COPY_THRESHOLD;
+    }
+}
+
+// Аналог memcpy с потоковыми записями. Невыровненные начало и конец dst копируются обычным memcpy.
+// Завершается барьером sfence, после которого записи упорядочены с последующими записями потока
+inline void StreamingCopy(void* dst, const void* src, size_t bytes) noexcept {
+    if (bytes == 0) {
+        return;
+    }
+#if VECTOR_STREAMING_X86
+    const size_t width = streaming_detail::HasAvx() ? 32 : 16;
+    char* out = static_cast<char*>(dst);
+    const char* in = static_cast<const char*>(src);
+    const size_t head = std::min(bytes, (width - reinterpret_cast<uintptr_t>(out) % width) % width);
+    std::memcpy(out, in, head);
+    out += head;
+    in += head;
+    bytes -= head;
+    const size_t body = bytes - bytes % width;
+    if (width == 32) {
+        streaming_detail::StreamAvx(out, in, body);
+    }
+    else {
+        streaming_detail::StreamSse2(out, in, body);
+    }
+    _mm_sfence();
+    std::memcpy(out + body, in + body, bytes - body);
+#else
+    std::memcpy(dst, src, bytes);
+#endif
+}
+
+// Копирует bytes байт потоковыми записями или memcpy в зависимости от hint
+inline void CopyBytes(void* dst, const void* src, size_t bytes, StreamingHint hint) noexcept {
+    if (UseStreamingCopy(bytes, hint)) {
+        StreamingCopy(dst, src, bytes);
+    }
+    else if (bytes != 0) {
+        std::memcpy(dst, src, bytes);
+    }
+}
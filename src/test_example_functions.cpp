@@ -1,10 +1,39 @@
 #include "test_example_functions.h"
 
+#include "allocators.h"
+#include "concurrent_vector.h"
+#include "flat_map.h"
+#include "gap_vector.h"
+#include "instrumentation.h"
+#include "memory_resource.h"
+#include "numeric.h"
+#include "parallel.h"
+#include "segmented_vector.h"
+#include "shared_vector.h"
+#if !defined(_WIN32)
+#include "mapped_vector.h"
+#endif
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
 #include "vector.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <sstream>
 #include <vector>
 
@@ -24,7 +53,7 @@ void RunTestImpl(Func& func, const string& func_name) {
 
 namespace test_vector {
 
-// "" ,     
+// "Магическое" число, используемое для отслеживания живости объекта
 inline const uint32_t DEFAULT_COOKIE = 0xdeadbeef;
 
 struct TestObj {
@@ -374,8 +403,8 @@ void TestResizePushPopBack() {
     {
         Vector<TestObj> v(1);
         assert(v.Size() == v.Capacity());
-        //  PushBack      
-        //    
+        // Операция PushBack существующего элемента вектора должна быть безопасна
+        // даже при реаллокации памяти
         v.PushBack(v[0]);
         assert(v[0].IsAlive());
         assert(v[1].IsAlive());
@@ -383,8 +412,8 @@ void TestResizePushPopBack() {
     {
         Vector<TestObj> v(1);
         assert(v.Size() == v.Capacity());
-        //  PushBack        
-        //    
+        // Операция PushBack для перемещения существующего элемента вектора должна быть безопасна
+        // даже при реаллокации памяти
         v.PushBack(std::move(v[0]));
         assert(v[0].IsAlive());
         assert(v[1].IsAlive());
@@ -410,8 +439,8 @@ void TestEmplaceBack() {
     {
         Vector<TestObj> v(1);
         assert(v.Size() == v.Capacity());
-        //  EmplaceBack      
-        //    
+        // Операция EmplaceBack существующего элемента вектора должна быть безопасна
+        // даже при реаллокации памяти
         v.EmplaceBack(v[0]);
         assert(v[0].IsAlive());
         assert(v[1].IsAlive());
@@ -576,6 +605,1817 @@ void TestInsertEmplace() {
         assert(Obj::num_moved == 0);
         assert(Obj::GetAliveObjectCount() == SIZE - 1);
     }
+    {
+        // Вставка в конец при свободной вместимости не затрагивает последний элемент
+        Vector<std::string> v;
+        v.Reserve(SIZE);
+        v.PushBack("first");
+        v.PushBack("last");
+        auto* pos = v.Emplace(v.cend(), "new");
+        assert(pos == v.begin() + 2 && v.Size() == 3);
+        assert(v[0] == "first" && v[1] == "last" && v[2] == "new");
+    }
+    {
+        // Удаление в позиции end() отклоняется, вектор не меняется
+        Vector<int> v = { 1, 2, 3 };
+        Vector<std::string> strings = { "a"s, "b"s };
+        try {
+            v.Erase(v.cend());
+            assert(false);
+        }
+        catch (const std::range_error&) {
+        }
+        try {
+            strings.Erase(strings.cend());
+            assert(false);
+        }
+        catch (const std::range_error&) {
+        }
+        assert(v.Size() == 3 && v[2] == 3 && strings.Size() == 2 && strings[1] == "b"s);
+        v.Erase(v.cend() - 1);
+        assert(v.Size() == 2 && v[1] == 2);
+    }
+}
+
+// Тип с явно разрешённым побайтовым переносом в памяти
+struct RelocObj {
+    explicit RelocObj(int id)
+        : id(std::make_unique<int>(id))
+    {
+    }
+
+    RelocObj(RelocObj&& other) noexcept
+        : id(std::move(other.id))
+    {
+        ++num_moved;
+    }
+
+    RelocObj& operator=(RelocObj&& other) noexcept {
+        id = std::move(other.id);
+        ++num_moved;
+        return *this;
+    }
+
+    ~RelocObj() {
+        ++num_destroyed;
+    }
+
+    static void ResetCounters() {
+        num_moved = 0;
+        num_destroyed = 0;
+    }
+
+    std::unique_ptr<int> id;
+
+    static inline int num_moved = 0;
+    static inline int num_destroyed = 0;
+};
+
+}  // namespace test_vector
+
+template <>
+struct IsTriviallyRelocatable<test_vector::RelocObj> : std::true_type {
+};
+
+namespace test_vector {
+
+void TestTriviallyRelocatable() {
+    const int SIZE = 100;
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(*v[0] == 0 && *v[SIZE - 1] == SIZE - 1);
+
+        v.Reserve(SIZE * 2);
+        auto pos = v.Emplace(v.cbegin() + 1, std::make_unique<int>(-1));
+        assert(v.Capacity() == SIZE * 2);
+        assert(&*pos == &v[1]);
+        assert(*v[0] == 0 && *v[1] == -1 && *v[2] == 1 && *v[SIZE] == SIZE - 1);
+
+        pos = v.Erase(v.cbegin() + 1);
+        assert(v.Size() == SIZE);
+        assert(&*pos == &v[1]);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(*v[i] == i);
+        }
+    }
+    {
+        RelocObj::ResetCounters();
+        {
+            Vector<RelocObj> v;
+            for (int i = 0; i < SIZE; ++i) {
+                v.EmplaceBack(i);
+            }
+            v.Emplace(v.cbegin() + SIZE / 2, -1);
+            assert(v.Size() == SIZE + 1);
+            assert(*v[SIZE / 2].id == -1);
+            assert(*v[SIZE / 2 + 1].id == SIZE / 2);
+
+            v.Emplace(v.cbegin(), -2);
+            v.Reserve(v.Capacity() * 2);
+            v.Erase(v.cbegin() + 1);
+            assert(*v[0].id == -2 && *v[1].id == 1);
+            assert(RelocObj::num_moved == 0);
+            assert(RelocObj::num_destroyed == 1);
+        }
+        assert(RelocObj::num_destroyed == SIZE + 2);
+    }
+    {
+        Vector<int> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        // Вставка существующего элемента при реаллокации и без неё
+        v.Insert(v.cbegin(), v[1]);
+        v.Insert(v.cbegin() + 1, v[2]);
+        assert(v.Size() == 4);
+        assert(v[0] == 2 && v[1] == 2 && v[2] == 1 && v[3] == 2);
+    }
+}
+
+// Ресурс-обёртка, подсчитывающий обращения к вышестоящему ресурсу
+struct CountingResource : std::pmr::memory_resource {
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++num_allocations;
+        bytes_in_use += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* buf, size_t bytes, size_t alignment) override {
+        ++num_deallocations;
+        bytes_in_use -= bytes;
+        std::pmr::new_delete_resource()->deallocate(buf, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    size_t num_allocations = 0;
+    size_t num_deallocations = 0;
+    size_t bytes_in_use = 0;
+};
+
+void TestAllocator() {
+    const size_t SIZE = 1000;
+    {
+        CountingResource upstream;
+        {
+            Vector<int, ResourceAllocator<int>> v(&upstream);
+            for (size_t i = 0; i < SIZE; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+            assert(v.GetAllocator().Resource() == &upstream);
+            assert(upstream.num_allocations == 11);
+            assert(upstream.num_deallocations == 10);
+
+            Vector<int, ResourceAllocator<int>> v_copy(v);
+            assert(v_copy.GetAllocator().Resource() == &upstream);
+            assert(v_copy[SIZE - 1] == SIZE - 1);
+
+            Vector<int, ResourceAllocator<int>> v_moved(std::move(v));
+            assert(v_moved.GetAllocator().Resource() == &upstream);
+            assert(v_moved.Size() == SIZE);
+        }
+        assert(upstream.num_allocations == upstream.num_deallocations);
+        assert(upstream.bytes_in_use == 0);
+    }
+    {
+        CountingResource upstream;
+        ArenaResource arena(ArenaResource::DEFAULT_BLOCK_SIZE, &upstream);
+        for (int request = 0; request < 10; ++request) {
+            Vector<Vector<std::string, ResourceAllocator<std::string>>,
+                   ResourceAllocator<Vector<std::string, ResourceAllocator<std::string>>>> rows(&arena);
+            for (size_t i = 0; i < 100; ++i) {
+                rows.EmplaceBack(&arena).PushBack(std::to_string(i));
+            }
+            assert(rows.Size() == 100);
+            assert(rows[99][0] == "99"s);
+        }
+        assert(upstream.num_allocations > 0);
+        assert(upstream.num_deallocations == 0);
+
+        const size_t num_blocks = upstream.num_allocations;
+        arena.Release();
+        assert(upstream.num_deallocations == num_blocks);
+        assert(upstream.bytes_in_use == 0);
+
+        Vector<double, ResourceAllocator<double>> v(SIZE, &arena);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % alignof(double) == 0);
+        assert(upstream.num_allocations == num_blocks + 1);
+    }
+    {
+        CountingResource upstream;
+        PoolResource pool(&upstream);
+        const void* first_buffer = nullptr;
+        for (int i = 0; i < 100; ++i) {
+            Vector<int, ResourceAllocator<int>> v(10, &pool);
+            if (first_buffer == nullptr) {
+                first_buffer = v.begin();
+            }
+            // Освобождённый фрагмент переиспользуется следующим вектором того же класса размера
+            assert(v.begin() == first_buffer);
+        }
+        assert(upstream.num_allocations == 1);
+        assert(PoolResource::ClassSize(10 * sizeof(int)) == 64);
+
+        Vector<char, ResourceAllocator<char>> large(PoolResource::MAX_POOLED_SIZE + 1, &pool);
+        assert(upstream.num_allocations == 2);
+    }
+    {
+        // Размер, при котором n * sizeof(T) переполняется, отклоняется до обращения к ресурсу
+        CountingResource upstream;
+        ArenaResource arena(ArenaResource::DEFAULT_BLOCK_SIZE, &upstream);
+        ResourceAllocator<double> alloc(&arena);
+        try {
+            alloc.allocate(SIZE_MAX / sizeof(double) + 2);
+            assert(false);
+        }
+        catch (const std::bad_array_new_length&) {
+        }
+        assert(upstream.num_allocations == 0 && alloc.max_size() == allocator_detail::MaxElements<double>());
+    }
+}
+
+void TestReallocGrowth() {
+    // Рост проходит через realloc, затем через mremap после порога в 1 МиБ
+    const int SIZE = 1'000'000;
+    {
+        Vector<int, ReallocAllocator<int>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == SIZE);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(v[i] == i);
+        }
+
+        v.Emplace(v.cbegin() + 1, v[SIZE - 1]);
+        assert(v[0] == 0 && v[1] == SIZE - 1 && v[2] == 1);
+        v.Erase(v.cbegin() + 1);
+
+        // Переход через порог при резервировании копирует данные в отображённую память
+        Vector<int, ReallocAllocator<int>> v_small;
+        v_small.PushBack(42);
+        v_small.Reserve(SIZE);
+        assert(v_small.Capacity() == SIZE && v_small[0] == 42);
+    }
+    {
+        Vector<std::unique_ptr<int>, ReallocAllocator<std::unique_ptr<int>>> v;
+        for (int i = 0; i < 100; ++i) {
+            v.Emplace(v.cbegin(), std::make_unique<int>(i));
+        }
+        assert(*v[0] == 99 && *v[99] == 0);
+    }
+    {
+        RawMemory<int, ReallocAllocator<int>> memory(SIZE);
+        memory[SIZE - 1] = 1;
+        memory[0] = 42;
+        memory.Reallocate(10);
+        assert(memory.Capacity() == 10 && memory[0] == 42);
+        memory.Reallocate(0);
+        assert(memory.Capacity() == 0 && memory.GetAddress() == nullptr);
+    }
+    {
+        // Размер, при котором n * sizeof(T) переполняется, отклоняется до вызова malloc и realloc
+        ReallocAllocator<int> alloc;
+        const size_t too_many = SIZE_MAX / sizeof(int) + 2;
+        try {
+            alloc.allocate(too_many);
+            assert(false);
+        }
+        catch (const std::bad_array_new_length&) {
+        }
+        int* buf = alloc.allocate(4);
+        try {
+            alloc.reallocate(buf, 4, too_many);
+            assert(false);
+        }
+        catch (const std::bad_array_new_length&) {
+        }
+        alloc.deallocate(buf, 4);
+        assert(alloc.max_size() == std::allocator_traits<std::allocator<int>>::max_size(std::allocator<int>()));
+        try {
+            AlignedAllocator<int, 64>().allocate(too_many);
+            assert(false);
+        }
+        catch (const std::bad_array_new_length&) {
+        }
+    }
+}
+
+void TestSmallVector() {
+    const int ID = 42;
+    {
+        Obj::ResetCounters();
+        CountingResource upstream;
+        SmallVector<Obj, 4, ResourceAllocator<Obj>> v(&upstream);
+        const auto* inline_data = v.begin();
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(v.IsInline() && v.Capacity() == 4 && v.begin() == inline_data);
+        assert(Obj::num_moved == 0 && Obj::num_copied == 0);
+        assert(upstream.num_allocations == 0);
+
+        v.EmplaceBack(ID);
+        assert(upstream.num_allocations == 1);
+        assert(!v.IsInline() && v.Capacity() == 8 && v.Size() == 5);
+        assert(v[0].id == 0 && v[3].id == 3 && v[4].id == ID);
+        assert(Obj::num_moved == 4);
+        assert(Obj::GetAliveObjectCount() == 5);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<TestObj, 2> v(2);
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin() + 1, std::move(v[2]));
+        assert(v.Size() == 4);
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+            }));
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, 4> v;
+        v.EmplaceBack(1);
+        v.EmplaceBack(3);
+        v.Emplace(v.cbegin() + 1, 2);
+        v.Emplace(v.cbegin(), 0);
+        assert(v.IsInline());
+        v.Emplace(v.cbegin() + 2, ID);
+        assert(!v.IsInline() && v.Size() == 5);
+        assert(v[0].id == 0 && v[1].id == 1 && v[2].id == ID && v[3].id == 2 && v[4].id == 3);
+        auto pos = v.Erase(v.cbegin() + 2);
+        assert(pos->id == 2 && v.Size() == 4);
+
+        v.Resize(2);
+        assert(v.Size() == 2 && v[1].id == 1);
+        v.Resize(6);
+        assert(v.Size() == 6 && v[5].id == 0);
+        v.PopBack();
+        assert(Obj::GetAliveObjectCount() == 5);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<std::string, 2> small;
+        small.PushBack("a"s);
+        SmallVector<std::string, 2> large;
+        for (int i = 0; i < 5; ++i) {
+            large.PushBack(std::to_string(i));
+        }
+        const auto* large_data = large.begin();
+
+        small.Swap(large);
+        assert(small.Size() == 5 && !small.IsInline() && small.begin() == large_data);
+        assert(large.Size() == 1 && large.IsInline() && large[0] == "a"s);
+
+        SmallVector<std::string, 2> moved(std::move(small));
+        assert(moved.begin() == large_data && small.Size() == 0 && small.IsInline());
+        moved = std::move(large);
+        assert(moved.Size() == 1 && moved.IsInline() && moved[0] == "a"s);
+
+        SmallVector<std::string, 2> copy(moved);
+        copy.PushBack("b"s);
+        copy.PushBack("c"s);
+        moved = copy;
+        assert(moved.Size() == 3 && moved[2] == "c"s && copy.Size() == 3);
+    }
+    {
+        // Перемещающее присваивание передаёт аллокатор вместе с содержимым, как у Vector
+        CountingResource first;
+        CountingResource second;
+        SmallVector<int, 2, ResourceAllocator<int>> heap(&first);
+        SmallVector<int, 2, ResourceAllocator<int>> small(&second);
+        for (int i = 0; i < 3; ++i) {
+            heap.PushBack(i);
+        }
+        small.PushBack(ID);
+        heap = std::move(small);
+        assert(heap.IsInline() && heap.Size() == 1 && heap[0] == ID);
+        assert(first.bytes_in_use == 0 && heap.GetAllocator().Resource() == &second);
+        heap.PushBack(1);
+        heap.PushBack(2);
+        assert(!heap.IsInline() && second.num_allocations == 1 && first.num_allocations == 1);
+
+        SmallVector<int, 2, ResourceAllocator<int>> target(&first);
+        target = std::move(heap);
+        assert(target.Size() == 3 && target.GetAllocator().Resource() == &second);
+        for (int i = 0; i < 3; ++i) {
+            target.PushBack(i);
+        }
+        assert(second.num_allocations == 2 && first.num_allocations == 1);
+    }
+}
+
+template <typename GrowthPolicy, typename T = int>
+std::vector<size_t> CollectCapacities(size_t count) {
+    std::vector<size_t> capacities;
+    Vector<T, std::allocator<T>, GrowthPolicy> v;
+    for (size_t i = 0; i < count; ++i) {
+        v.EmplaceBack();
+        if (capacities.empty() || capacities.back() != v.Capacity()) {
+            capacities.push_back(v.Capacity());
+        }
+    }
+    return capacities;
+}
+
+void TestGrowthPolicy() {
+    assert((CollectCapacities<DoublingGrowth>(10) == std::vector<size_t>{ 1, 2, 4, 8, 16 }));
+    assert((CollectCapacities<OneAndHalfGrowth>(10) == std::vector<size_t>{ 1, 2, 3, 4, 6, 9, 13 }));
+    assert((CollectCapacities<CacheLineGrowth<>>(20) == std::vector<size_t>{ 16, 32 }));
+    assert((CollectCapacities<CacheLineGrowth<OneAndHalfGrowth>, double>(10) == std::vector<size_t>{ 8, 12 }));
+    assert((CollectCapacities<CacheLineGrowth<>, std::array<char, 100>>(2) == std::vector<size_t>{ 1, 2 }));
+
+    // 12-байтовые элементы: 1 -> 16 байт, 2 -> 32 байта, 4 -> 64 байта
+    using Triple = std::array<int, 3>;
+    assert((CollectCapacities<SizeClassGrowth<>, Triple>(6) == std::vector<size_t>{ 1, 2, 5, 10 }));
+    assert((SizeClassGrowth<>::NextCapacity<int>(100, 101) == 256));
+    assert((SizeClassGrowth<>::NextCapacity<int>(1000, 1001) == 2048));
+    assert((SizeClassGrowth<OneAndHalfGrowth>::NextCapacity<int>(2048, 2049) == 3072));
+
+    Obj::ResetCounters();
+    {
+        Vector<Obj, std::allocator<Obj>, OneAndHalfGrowth> v(10);
+        v.Emplace(v.cbegin() + 5, 42);
+        assert(v.Capacity() == 15 && v[5].id == 42);
+        assert(Obj::num_moved == 10);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void TestRangeOperations() {
+    {
+        Vector<int> v{ 1, 2, 3 };
+        assert(v.Size() == 3 && v.Capacity() == 3);
+        assert(v[0] == 1 && v[2] == 3);
+
+        std::vector<int> batch{ 10, 11, 12, 13 };
+        v.Append(batch.begin(), batch.end());
+        assert(v.Size() == 7 && v.Capacity() == 7);
+        assert(v[3] == 10 && v[6] == 13);
+
+        // Вставка с реаллокацией, затем без неё при длинном и коротком хвосте
+        auto pos = v.Insert(v.cbegin() + 1, batch.begin(), batch.begin() + 2);
+        assert(&*pos == &v[1] && v.Size() == 9 && v.Capacity() == 14);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 1, 10, 11, 2, 3, 10, 11, 12, 13 }));
+        v.Insert(v.cbegin(), 2, v[8]);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 13, 13, 1, 10, 11, 2, 3, 10, 11, 12, 13 }));
+        v.Insert(v.cend() - 1, batch.begin(), batch.end());
+        assert(v.Size() == 15 && v.Capacity() == 28 && v[10] == 10 && v[13] == 13 && v[14] == 13);
+
+        std::istringstream input("7 8 9");
+        v.Insert(v.cbegin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v[0] == 13 && v[1] == 7 && v[2] == 8 && v[3] == 9 && v[4] == 13);
+
+        v.Assign({ 5, 6 });
+        assert(v.Size() == 2 && v[0] == 5 && v[1] == 6);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(10);
+        v.Reserve(100);
+        std::vector<Obj> batch(5);
+        const int old_moved = Obj::num_moved;
+        v.Insert(v.cbegin() + 2, batch.begin(), batch.end());
+        assert(v.Size() == 15);
+        assert(Obj::num_copied == 0 && Obj::num_assigned == 5);
+        assert(Obj::num_moved == old_moved + 5 && Obj::num_move_assigned == 3);
+        assert(Obj::GetAliveObjectCount() == 20);
+
+        v.Insert(v.cbegin() + 14, batch.begin(), batch.end());
+        assert(v.Size() == 20);
+        assert(Obj::GetAliveObjectCount() == 25);
+
+        v.Insert(v.cbegin(), 100, Obj(7));
+        assert(v.Size() == 120 && v.Capacity() == 200);
+        assert(v[0].id == 7 && v[99].id == 7 && v[100].id == 0);
+        assert(Obj::GetAliveObjectCount() == 125);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<std::string> v{ "a"s, "b"s, "c"s, "d"s };
+        std::vector<std::string> batch{ "x"s, "y"s };
+        v.Insert(v.cbegin() + 1, batch.begin(), batch.end());
+        v.Reserve(100);
+        v.Insert(v.cbegin() + 5, batch.begin(), batch.end());
+        v.Insert(v.cbegin() + 1, 3, "z"s);
+        assert((std::vector<std::string>(v.begin(), v.end())
+            == std::vector<std::string>{ "a"s, "z"s, "z"s, "z"s, "x"s, "y"s, "b"s, "c"s, "x"s, "y"s, "d"s }));
+
+        std::list<std::string> words{ "p"s, "q"s, "r"s };
+        v.Assign(words.begin(), words.end());
+        assert(v.Size() == 3 && v[2] == "r"s && v.Capacity() == 100);
+        std::vector<std::string> many(50, "m"s);
+        v.Assign(many.begin(), many.end());
+        assert(v.Size() == 50 && v[49] == "m"s);
+        std::vector<std::string> more(200, "n"s);
+        v.Assign(more.begin(), more.end());
+        assert(v.Size() == 200 && v.Capacity() == 200 && v[199] == "n"s);
+
+        Vector<std::string> copy(words.begin(), words.end());
+        assert(copy.Size() == 3 && copy[0] == "p"s);
+    }
+    {
+        Vector<std::unique_ptr<int>> v;
+        std::vector<std::unique_ptr<int>> batch;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+            batch.push_back(std::make_unique<int>(i + 10));
+        }
+        v.Insert(v.cbegin() + 2, std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+        assert(v.Size() == 10 && *v[1] == 1 && *v[2] == 10 && *v[6] == 14 && *v[7] == 2);
+    }
+}
+
+void TestEraseRange() {
+    const int SIZE = 1000;
+    {
+        Vector<int> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        auto pos = v.Erase(v.cbegin() + 10, v.cbegin() + 20);
+        assert(v.Size() == SIZE - 10 && *pos == 20 && v[9] == 9);
+        pos = v.Erase(v.cbegin() + 5, v.cbegin() + 5);
+        assert(v.Size() == SIZE - 10 && *pos == 5);
+
+        size_t removed = EraseIf(v, [](int value) {
+            return value % 3 == 0;
+        });
+        assert(removed == 331 && v.Size() == SIZE - 10 - 331);
+        assert(std::none_of(v.begin(), v.end(), [](int value) {
+            return value % 3 == 0;
+            }));
+        assert(std::is_sorted(v.begin(), v.end()));
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(v.Size() == 7 && v[2].id == 5 && v[6].id == 9);
+        assert(Obj::num_move_assigned == 5);
+        assert(Obj::GetAliveObjectCount() == 7);
+
+        size_t removed = v.EraseIf([](const Obj& obj) {
+            return obj.id % 2 == 1;
+        });
+        assert(removed == 4 && v.Size() == 3);
+        assert(v[0].id == 0 && v[1].id == 6 && v[2].id == 8);
+        assert(Obj::GetAliveObjectCount() == 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        RelocObj::ResetCounters();
+        {
+            Vector<RelocObj> v;
+            for (int i = 0; i < 10; ++i) {
+                v.EmplaceBack(i);
+            }
+            size_t checked = 0;
+            try {
+                v.EraseIf([&checked](const RelocObj& obj) {
+                    if (++checked == 8) {
+                        throw std::runtime_error("Oops");
+                    }
+                    return *obj.id < 4;
+                });
+                assert(false && "Exception is expected");
+            }
+            catch (const std::runtime_error&) {
+            }
+            // Удалены только проверенные элементы, порядок остальных сохранён
+            assert(v.Size() == 6 && *v[0].id == 4 && *v[5].id == 9);
+            assert(RelocObj::num_destroyed == 4 && RelocObj::num_moved == 0);
+        }
+        assert(RelocObj::num_destroyed == 10);
+    }
+}
+
+void TestDefaultInit() {
+    const size_t SIZE = 1000;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, default_init);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(Obj::num_default_constructed == SIZE);
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(Obj::num_destroyed == SIZE / 2);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2 && Obj::GetAliveObjectCount() == SIZE * 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<uint32_t> v(SIZE, default_init);
+        std::fill(v.begin(), v.end(), DEFAULT_COOKIE);
+
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v[SIZE - 1] == DEFAULT_COOKIE);
+        std::iota(v.begin() + SIZE, v.end(), 0);
+        assert(v[SIZE * 2 - 1] == SIZE - 1);
+
+        uint32_t* first_new = v.ResizeForOverwrite(SIZE * 3);
+        assert(first_new == v.Data() + SIZE * 2 && v.Size() == SIZE * 3);
+        std::memset(first_new, 0, SIZE * sizeof(uint32_t));
+        assert(v[SIZE * 3 - 1] == 0 && v[SIZE - 1] == DEFAULT_COOKIE);
+
+        first_new = v.ResizeForOverwrite(10);
+        assert(first_new == v.Data() + 10 && v.Size() == 10);
+        const auto& cv = v;
+        assert(cv.Data() == &v[0]);
+    }
+}
+
+struct alignas(64) CacheLineObj {
+    int value = 0;
+};
+
+void TestAlignment() {
+    const size_t SIZE = 100;
+    auto is_aligned = [](const void* ptr, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+    };
+    {
+        // Стандартный аллокатор учитывает alignof(T) больше выравнивания operator new по умолчанию
+        Vector<CacheLineObj> v(SIZE);
+        assert(is_aligned(v.Data(), alignof(CacheLineObj)));
+        v.Reserve(SIZE * 2);
+        assert(is_aligned(v.Data(), alignof(CacheLineObj)));
+    }
+    {
+        Vector<float, AlignedAllocator<float>> v(SIZE);
+        static_assert(AlignedAllocator<float>::ALIGNMENT == 16);
+        assert(is_aligned(v.Data(), 16));
+    }
+    {
+        Vector<float, AlignedAllocator<float, 64>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(is_aligned(v.Data(), 64));
+        }
+        Vector<float, AlignedAllocator<float, 64>> v_copy(v);
+        assert(is_aligned(v_copy.Data(), 64) && v_copy[SIZE - 1] == SIZE - 1);
+    }
+    {
+        Vector<std::string, AlignedAllocator<std::string, 4096>> v;
+        v.Insert(v.cend(), 10, "page"s);
+        assert(is_aligned(v.Data(), 4096) && v[9] == "page"s);
+    }
+}
+
+void TestHugePageAllocator() {
+    using Allocator = HugePageAllocator<uint64_t>;
+    const size_t LARGE_SIZE = Allocator::THRESHOLD / sizeof(uint64_t) * 4;
+    {
+        Vector<uint64_t, Allocator> v(LARGE_SIZE, default_init);
+        assert(reinterpret_cast<uintptr_t>(v.Data()) % Allocator::HUGE_PAGE_SIZE == 0);
+        std::iota(v.begin(), v.end(), uint64_t{ 0 });
+        v.PushBack(LARGE_SIZE);
+        assert(reinterpret_cast<uintptr_t>(v.Data()) % Allocator::HUGE_PAGE_SIZE == 0);
+        for (size_t i = 0; i <= LARGE_SIZE; i += 4099) {
+            assert(v[i] == i);
+        }
+        assert(v[LARGE_SIZE] == LARGE_SIZE);
+    }
+    {
+        // Небольшие буферы не отображаются и выделяются обычным образом
+        Vector<uint64_t, Allocator> v;
+        for (uint64_t i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v[999] == 999);
+    }
+}
+
+#if !defined(_WIN32)
+struct Record {
+    uint64_t key;
+    double value;
+    char tag[16];
+};
+
+void TestMappedVector() {
+    const std::string path = (std::filesystem::temp_directory_path() / "mapped_vector_test.bin").string();
+    const size_t SIZE = 100'000;
+    {
+        auto v = MappedVector<Record>::Create(path);
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(Record{ i, i * 0.5, "record" });
+        }
+        assert(v.Size() == SIZE && v.Capacity() >= SIZE);
+        v.EmplaceBack(v[0]);
+        v.PopBack();
+        v.Flush();
+    }
+    {
+        const auto v = MappedVector<Record>::Open(path);
+        assert(v.IsReadOnly() && v.Size() == SIZE);
+        assert(v[SIZE - 1].key == SIZE - 1 && v[SIZE - 1].value == (SIZE - 1) * 0.5);
+        assert(std::string(v[10].tag) == "record"s);
+
+        // Алгоритмы работают с MappedVector так же, как с Vector
+        uint64_t key_sum = std::accumulate(v.begin(), v.end(), uint64_t{ 0 }, [](uint64_t sum, const Record& record) {
+            return sum + record.key;
+        });
+        assert(key_sum == SIZE * (SIZE - 1) / 2);
+    }
+    {
+        auto v = MappedVector<Record>::Open(path);
+        try {
+            v.PushBack(Record{});
+            assert(false && "Exception is expected");
+        }
+        catch (const std::logic_error&) {
+        }
+
+        auto writable = MappedVector<Record>::Open(path, true);
+        writable.Resize(10);
+        writable[9].key = 42;
+        MappedVector<Record> moved(std::move(writable));
+        assert(moved.Size() == 10 && moved[9].key == 42 && !writable.IsOpen());
+    }
+    {
+        auto v = MappedVector<double>::Create(path, 8);
+        assert(v.Capacity() == 8);
+        try {
+            auto wrong_type = MappedVector<Record>::Open(path);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        // Повреждённая вместимость, при которой размер отображения в байтах переполняется, отклоняется
+        const uint64_t capacity = SIZE_MAX / sizeof(double) + 1;
+        int fd = open(path.c_str(), O_WRONLY);
+        assert(fd >= 0);
+        assert(pwrite(fd, &capacity, sizeof(capacity), 3 * sizeof(uint64_t)) == static_cast<ssize_t>(sizeof(capacity)));
+        close(fd);
+        try {
+            auto corrupt = MappedVector<double>::Open(path);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    {
+        // Вместимость, размер файла для которой не помещается в off_t, отклоняется до изменения файла
+        auto v = MappedVector<double>::Create(path, 4);
+        v.PushBack(1.5);
+        try {
+            v.Reserve(SIZE_MAX / sizeof(double));
+            assert(false && "Exception is expected");
+        }
+        catch (const std::length_error&) {
+        }
+        assert(v.Capacity() == 4 && v.Size() == 1);
+        v.PushBack(2.5);
+        assert(v[0] == 1.5 && v[1] == 2.5);
+        try {
+            auto huge = MappedVector<double>::Create(path, SIZE_MAX / sizeof(double));
+            assert(false && "Exception is expected");
+        }
+        catch (const std::length_error&) {
+        }
+    }
+    std::filesystem::remove(path);
+}
+#endif
+
+}  // namespace test_vector
+
+template <>
+struct VectorCodec<test_vector::Obj> {
+    static void Write(std::ostream& out, const test_vector::Obj& obj) {
+        out.write(reinterpret_cast<const char*>(&obj.id), sizeof(obj.id));
+        VectorCodec<std::string>::Write(out, obj.name);
+    }
+
+    static test_vector::Obj Read(std::istream& in) {
+        int id = 0;
+        in.read(reinterpret_cast<char*>(&id), sizeof(id));
+        return test_vector::Obj(id, VectorCodec<std::string>::Read(in));
+    }
+};
+
+namespace test_vector {
+
+void TestSerialization() {
+    const int SIZE = 300'000;
+    {
+        Vector<int> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i * 3);
+        }
+        std::stringstream stream;
+        v.WriteTo(stream);
+        assert(stream.str().size() == sizeof(VectorStreamHeader) + SIZE * sizeof(int));
+
+        Vector<int> restored{ 1, 2, 3 };
+        restored.ReadFrom(stream);
+        assert(restored.Size() == SIZE && restored.Capacity() == SIZE);
+        assert(std::equal(v.begin(), v.end(), restored.begin()));
+
+        // Усечённый поток и поток другого типа не меняют вектор
+        std::stringstream truncated(stream.str().substr(0, stream.str().size() / 2));
+        try {
+            restored.ReadFrom(truncated);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(restored.Size() == SIZE);
+
+        // Повреждённый размер в заголовке не приводит к выделению памяти под весь заявленный размер
+        VectorStreamHeader huge;
+        huge.is_block = 1;
+        huge.element_size = sizeof(int);
+        huge.size = uint64_t{ 1 } << 60;
+        std::string corrupt(reinterpret_cast<const char*>(&huge), sizeof(huge));
+        corrupt.append(64, '\0');
+        std::stringstream corrupt_stream(corrupt);
+        try {
+            restored.ReadFrom(corrupt_stream);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(restored.Size() == SIZE);
+        huge.is_block = 0;
+        huge.element_size = sizeof(std::string);
+        std::stringstream corrupt_strings(std::string(reinterpret_cast<const char*>(&huge), sizeof(huge)));
+        Vector<std::string> strings;
+        try {
+            strings.ReadFrom(corrupt_strings);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        std::stringstream wrong_type(stream.str());
+        Vector<double> doubles;
+        try {
+            doubles.ReadFrom(wrong_type);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    {
+        Vector<std::string> v{ "alpha"s, ""s, "gamma"s };
+        std::stringstream stream;
+        v.WriteTo(stream);
+        Vector<std::string> restored;
+        restored.ReadFrom(stream);
+        assert(restored.Size() == 3 && restored[0] == "alpha"s && restored[1].empty() && restored[2] == "gamma"s);
+
+        Vector<Obj> objects;
+        objects.EmplaceBack(1, "one"s);
+        objects.EmplaceBack(2, "two"s);
+        std::stringstream obj_stream;
+        objects.WriteTo(obj_stream);
+        Vector<Obj> obj_restored;
+        obj_restored.ReadFrom(obj_stream);
+        assert(obj_restored.Size() == 2 && obj_restored[0].id == 1 && obj_restored[1].id == 2);
+    }
+#if !defined(_WIN32)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "vector_io_test.bin").string();
+        Vector<double> v(SIZE);
+        std::iota(v.begin(), v.end(), 0.5);
+
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        v.WriteTo(fd);
+        lseek(fd, 0, SEEK_SET);
+        Vector<double> restored;
+        restored.ReadFrom(fd);
+
+        // Заголовок с повреждённым размером: ошибка чтения вместо выделения памяти под заявленный размер
+        VectorStreamHeader huge;
+        huge.is_block = 1;
+        huge.element_size = sizeof(double);
+        huge.size = uint64_t{ 1 } << 60;
+        lseek(fd, 0, SEEK_SET);
+        assert(write(fd, &huge, sizeof(huge)) == static_cast<ssize_t>(sizeof(huge)));
+        lseek(fd, 0, SEEK_SET);
+        try {
+            restored.ReadFrom(fd);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        close(fd);
+        std::filesystem::remove(path);
+        assert(restored.Size() == SIZE && restored[SIZE - 1] == SIZE - 0.5);
+    }
+#endif
+}
+
+template <typename T>
+void CheckNumericKernels(numeric::Isa isa) {
+    const auto close = [](T lhs, T rhs, size_t n) {
+        if constexpr (std::is_floating_point_v<T>) {
+            const T tolerance = std::numeric_limits<T>::epsilon() * static_cast<T>(n + 1) * 64;
+            return std::abs(lhs - rhs) <= tolerance * std::max({ T{ 1 }, std::abs(lhs), std::abs(rhs) });
+        }
+        else {
+            return lhs == rhs;
+        }
+    };
+    uint32_t seed = 12345;
+    const auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<T>(static_cast<int>(seed >> 16) % 201 - 100);
+    };
+    for (size_t n : { size_t{ 1 }, size_t{ 3 }, size_t{ 7 }, size_t{ 8 }, size_t{ 17 }, size_t{ 64 }, size_t{ 1003 } }) {
+        Vector<T> x(n);
+        Vector<T> y(n);
+        std::generate(x.begin(), x.end(), next);
+        std::generate(y.begin(), y.end(), next);
+
+        numeric::ForceIsa(numeric::Isa::SCALAR);
+        const T sum = numeric::Sum(x);
+        const T dot = numeric::Dot(x, y);
+        const size_t arg_max = numeric::ArgMax(x);
+        Vector<T> axpy = y;
+        numeric::Axpy(T{ 3 }, x, axpy);
+
+        numeric::ForceIsa(isa);
+        assert(close(numeric::Sum(x), sum, n));
+        assert(close(numeric::Dot(x, y), dot, n));
+        assert(numeric::Min(x) == *std::min_element(x.begin(), x.end()));
+        assert(numeric::Max(x) == *std::max_element(x.begin(), x.end()));
+        assert(numeric::ArgMax(x) == arg_max);
+        assert(arg_max == static_cast<size_t>(std::max_element(x.begin(), x.end()) - x.begin()));
+
+        Vector<T> result = y;
+        numeric::Axpy(T{ 3 }, x, result);
+        assert(std::equal(result.begin(), result.end(), axpy.begin()));
+        numeric::Add(x, y, result);
+        numeric::Mul(result, y, result);
+        numeric::Scale(result, T{ 2 });
+        for (size_t i = 0; i < n; ++i) {
+            assert(result[i] == (x[i] + y[i]) * y[i] * 2);
+        }
+    }
+    numeric::ForceIsa(numeric::DetectIsa());
+}
+
+void TestNumericKernels() {
+    for (numeric::Isa isa : { numeric::Isa::SCALAR, numeric::Isa::SSE42, numeric::Isa::AVX2 }) {
+        CheckNumericKernels<float>(isa);
+        CheckNumericKernels<double>(isa);
+        CheckNumericKernels<int32_t>(isa);
+        CheckNumericKernels<int64_t>(isa);
+    }
+    assert(numeric::ActiveIsa() == numeric::DetectIsa());
+
+    // Первый максимум при повторах попадает в разные дорожки
+    Vector<float> ties(100);
+    std::fill(ties.begin(), ties.end(), 1.0f);
+    ties[37] = ties[70] = ties[90] = 5.0f;
+    assert(numeric::ArgMax(ties) == 37);
+}
+
+void TestParallel() {
+    const size_t SIZE = 1'000'000;
+    {
+        Vector<int64_t> v{ 7 };
+        ParallelResize(v, SIZE);
+        assert(v.Size() == SIZE && v[0] == 7);
+        assert(std::all_of(v.begin() + 1, v.end(), [](int64_t x) { return x == 0; }));
+
+        ParallelResize(v, 2 * SIZE, v[0]);
+        assert(v.Size() == 2 * SIZE && v[SIZE - 1] == 0 && v[SIZE] == 7 && v[2 * SIZE - 1] == 7);
+        ParallelResize(v, SIZE);
+        assert(v.Size() == SIZE);
+
+        ParallelTransform(v.begin(), v.end(), v.begin(), [&v](const int64_t& x) { return x + (&x - v.Data()); });
+        ParallelForEach(v.begin(), v.end(), [](int64_t& x) { x *= 2; });
+        assert(v[0] == 14 && v[SIZE - 1] == 2 * static_cast<int64_t>(SIZE - 1));
+        const int64_t sum = ParallelReduce(v.begin(), v.end(), int64_t{ 1 }, std::plus<>());
+        assert(sum == std::accumulate(v.begin(), v.end(), int64_t{ 1 }));
+        assert(ParallelReduce(v.begin(), v.begin(), int64_t{ 5 }, std::plus<>()) == 5);
+
+        Vector<int64_t> copy = ParallelCopy(v);
+        assert(copy.Size() == SIZE && copy.Capacity() == SIZE);
+        assert(std::equal(v.begin(), v.end(), copy.begin()));
+        Vector<int64_t> assigned(SIZE * 2);
+        ParallelAssign(assigned, v);
+        assert(assigned.Size() == SIZE && assigned.Capacity() == SIZE * 2);
+        assert(std::equal(v.begin(), v.end(), assigned.begin()));
+    }
+    {
+        // Ассоциативная, но не коммутативная операция: порядок частичных результатов сохраняется
+        Vector<std::string> letters(100'000);
+        ParallelTransform(letters.begin(), letters.end(), letters.begin(), [&letters](const std::string& s) {
+            return std::string(1, static_cast<char>('a' + (&s - letters.Data()) % 26));
+        });
+        const std::string joined = ParallelReduce(letters.begin(), letters.end(), "<"s, std::plus<>());
+        assert(joined.size() == letters.Size() + 1 && joined.substr(0, 4) == "<abc"s);
+        assert(joined == std::accumulate(letters.begin(), letters.end(), "<"s));
+
+        // Копирование std::string может выбросить исключение, поэтому выполняется последовательно
+        Vector<std::string> strings;
+        ParallelResize(strings, SIZE / 10, "text"s);
+        assert(strings.Size() == SIZE / 10 && strings[SIZE / 10 - 1] == "text"s);
+        Vector<std::string> copy = ParallelCopy(strings);
+        assert(copy.Size() == strings.Size() && copy[0] == "text"s);
+    }
+}
+
+void TestConcurrentVector() {
+    const size_t THREADS = 8;
+    const size_t PER_THREAD = 50'000;
+    {
+        ConcurrentVector<size_t> v;
+        v.PushBack(0);
+        const size_t* first = &v[0];
+
+        std::atomic<bool> done = false;
+        std::atomic<size_t> checked = 0;
+        // Читатель проверяет опубликованные элементы, пока писатели добавляют новые
+        std::thread reader([&v, &done, &checked]() {
+            while (!done.load()) {
+                const size_t size = v.Size();
+                for (size_t i = 0; i < size; i += 97) {
+                    if (v.IsPublished(i)) {
+                        assert(i == 0 || v[i] % PER_THREAD < PER_THREAD);
+                        checked.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+
+        std::vector<std::thread> writers;
+        std::vector<std::vector<size_t>> indexes(THREADS);
+        for (size_t t = 0; t < THREADS; ++t) {
+            writers.emplace_back([&v, &indexes, t]() {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    indexes[t].push_back(v.PushBack(1 + t * PER_THREAD + i));
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+
+        assert(v.Size() == THREADS * PER_THREAD + 1);
+        assert(&v[0] == first);
+        std::vector<bool> seen(THREADS * PER_THREAD + 1);
+        for (size_t t = 0; t < THREADS; ++t) {
+            for (size_t i = 0; i < PER_THREAD; ++i) {
+                const size_t index = indexes[t][i];
+                assert(v.IsPublished(index) && v[index] == 1 + t * PER_THREAD + i);
+                assert(!seen[index]);
+                seen[index] = true;
+            }
+        }
+        assert(!v.IsPublished(v.Size()));
+    }
+    {
+        ConcurrentVector<std::string> strings;
+        strings.Reserve(1000);
+        std::vector<std::thread> writers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            writers.emplace_back([&strings]() {
+                for (int i = 0; i < 100; ++i) {
+                    strings.EmplaceBack(100, 'x');
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        assert(strings.Size() == THREADS * 100 && strings[THREADS * 100 - 1].size() == 100);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            ConcurrentVector<Obj> v;
+            v.EmplaceBack(1, "one"s);
+            // Исключение в конструкторе оставляет позицию неопубликованной
+            Obj::default_construction_throw_countdown = 1;
+            try {
+                v.EmplaceBack();
+                assert(false && "Exception is expected");
+            }
+            catch (const std::runtime_error&) {
+            }
+            v.EmplaceBack(3, "three"s);
+            assert(v.Size() == 3 && v.IsPublished(0) && !v.IsPublished(1) && v[2].id == 3);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void TestSegmentedVector() {
+    {
+        SegmentedVector<int, 16> v;
+        v.PushBack(0);
+        const int* first = &v[0];
+        for (int i = 1; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        // Элементы не перемещаются при росте
+        assert(&v[0] == first && *first == 0);
+        assert(v.Size() == 1000 && v.Capacity() == 1008 && v.ChunkCount() == 63);
+
+        std::reverse(v.begin(), v.end());
+        assert(v[0] == 999 && v[999] == 0);
+        std::sort(v.begin(), v.end());
+        assert(std::is_sorted(v.cbegin(), v.cend()) && std::lower_bound(v.begin(), v.end(), 500) - v.begin() == 500);
+        SegmentedVector<int, 16>::const_iterator it = v.begin() + 17;
+        assert(*it == 17 && it[3] == 20 && it - v.cbegin() == 17);
+
+        v.Insert(v.begin() + 16, -1);
+        assert(v.Size() == 1001 && v[15] == 15 && v[16] == -1 && v[17] == 16 && v[1000] == 999);
+        v.Erase(v.begin() + 16);
+        assert(v.Size() == 1000 && v[16] == 16 && v.Back() == 999);
+
+        v.Resize(10);
+        assert(v.Size() == 10 && v.ChunkCount() == 63);
+        v.Clear();
+        v.Resize(20);
+        assert(v[19] == 0);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            SegmentedVector<Obj, 8> v(20);
+            assert(Obj::num_default_constructed == 20 && v.ChunkCount() == 3);
+            v.EmplaceBack(5, "five"s);
+            SegmentedVector<Obj, 8> copy(v);
+            assert(copy.Size() == 21 && copy[20].id == 5);
+            SegmentedVector<Obj, 8> moved(std::move(copy));
+            assert(moved.Size() == 21 && copy.Size() == 0);
+            copy = moved;
+            moved = SegmentedVector<Obj, 8>{ Obj(1), Obj(2) };
+            assert(moved.Size() == 2 && moved[1].id == 2 && copy.Size() == 21);
+
+            // Исключение при увеличении размера откатывает созданные элементы
+            Obj::default_construction_throw_countdown = 5;
+            try {
+                v.Resize(40);
+                assert(false && "Exception is expected");
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 21);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void TestIncrementalGrowth() {
+    using IncrementalVector = Vector<int, std::allocator<int>, IncrementalGrowth<DoublingGrowth, 1>>;
+    {
+        IncrementalVector v;
+        size_t growths = 0;
+        for (int i = 0; i < 1000; ++i) {
+            const size_t capacity = v.Capacity();
+            // Перенос завершается до следующего роста
+            assert(v.Size() < capacity || !v.IsMigrating());
+            v.PushBack(i);
+            if (v.Capacity() != capacity) {
+                ++growths;
+                assert(v.IsMigrating() == (capacity > 1));
+            }
+            // Индексация работает во время переноса
+            for (int j = 0; j <= i; j += 7) {
+                assert(v[j] == j);
+            }
+            assert(v[i] == i);
+        }
+        assert(growths == 11 && v.Capacity() == 1024 && v.IsMigrating());
+
+        // Аргумент, ссылающийся на ещё не перенесённый элемент, остаётся действительным
+        for (int i = 0; i < 24; ++i) {
+            v.PushBack(0);
+        }
+        v.PushBack(v[900]);
+        assert(v.IsMigrating() && v[1024] == 900 && v[900] == 900);
+
+        // Копирование и запись читают оба буфера, не завершая перенос
+        const IncrementalVector& cref = v;
+        IncrementalVector copy(cref);
+        std::stringstream stream;
+        cref.WriteTo(stream);
+        assert(v.IsMigrating() && !copy.IsMigrating() && copy.Size() == v.Size());
+        IncrementalVector restored;
+        restored.ReadFrom(stream);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(copy[i] == v[i] && restored[i] == v[i]);
+        }
+
+        v.FinishMigration();
+        assert(cref.Data()[999] == 999 && cref.Data()[1000] == 0 && !v.IsMigrating());
+        assert(std::accumulate(v.begin(), v.begin() + 1000, 0) == 999 * 1000 / 2);
+    }
+    {
+        // Старый буфер освобождается после переноса, типы без тривиального перемещения переносятся конструктором
+        Obj::ResetCounters();
+        {
+            Vector<Obj, std::allocator<Obj>, IncrementalGrowth<>> v;
+            for (int i = 0; i < 70; ++i) {
+                v.EmplaceBack(i, "obj"s);
+            }
+            assert(v.IsMigrating() && v[5].id == 5 && v[69].id == 69);
+            Vector<Obj, std::allocator<Obj>, IncrementalGrowth<>> copy(v);
+            assert(copy.Size() == 70 && !copy.IsMigrating() && v.IsMigrating() && copy[5].id == 5 && copy[69].id == 69);
+            copy = v;
+            assert(copy.Size() == 70 && v.IsMigrating() && copy[40].id == 40);
+            for (int i = 0; i < 60; ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(v.IsMigrating());
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // Вставки и Append во время переноса сначала завершают его
+        Obj::ResetCounters();
+        {
+            Vector<Obj, std::allocator<Obj>, IncrementalGrowth<DoublingGrowth, 1>> v;
+            for (int i = 0; i < 65; ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(v.IsMigrating());
+            const std::vector<Obj> tail{Obj(100), Obj(101)};
+            v.Append(tail.begin(), tail.end());
+            assert(!v.IsMigrating() && v.Size() == 67 && v[64].id == 64 && v[65].id == 100 && v[66].id == 101);
+            for (int i = 0; i < 62; ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(v.IsMigrating());
+            v.Insert(v.end(), 2, Obj(200));
+            v.Insert(v.end(), tail.begin(), tail.end());
+            assert(!v.IsMigrating() && v.Size() == 133 && v[128].id == 61 && v[129].id == 200 && v[132].id == 101);
+            for (int i = 0; i < 67; ++i) {
+                assert(v[i].id == (i < 65 ? i : 35 + i));
+            }
+            assert(Obj::GetAliveObjectCount() == 135);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // Ядра numeric.h и ParallelCopy читают константный вектор по частям, не завершая перенос
+        Vector<double, std::allocator<double>, IncrementalGrowth<DoublingGrowth, 1>> x;
+        Vector<double, std::allocator<double>, IncrementalGrowth<DoublingGrowth, 1>> y;
+        for (int i = 0; i < 65; ++i) {
+            x.PushBack(i == 40 ? 1000.0 : i);
+        }
+        for (int i = 0; i < 65; ++i) {
+            y.PushBack(i < 64 ? 1.0 : 2.0);
+        }
+        y.FinishMigration();
+        const auto& cx = x;
+        assert(cx.IsMigrating());
+        double expected_sum = 0;
+        for (int i = 0; i < 65; ++i) {
+            expected_sum += cx[i];
+        }
+        assert(numeric::Sum(cx) == expected_sum);
+        assert(numeric::Dot(cx, y) == expected_sum + cx[64]);
+        assert(numeric::ArgMax(cx) == 40 && numeric::Max(cx) == 1000.0 && numeric::Min(cx) == 0.0);
+        decltype(x) out;
+        numeric::Add(cx, y, out);
+        numeric::Axpy(2.0, cx, y);
+        const auto copy = ParallelCopy(cx);
+        assert(cx.IsMigrating() && copy.Size() == 65);
+        for (int i = 0; i < 65; ++i) {
+            assert(copy[i] == cx[i] && out[i] == cx[i] + (i < 64 ? 1.0 : 2.0) && y[i] == out[i] + cx[i]);
+        }
+    }
+}
+
+void TestSoaVector() {
+    {
+        SoaVector<int, double, std::string> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i, i * 0.5, std::to_string(i));
+        }
+        assert(v.Size() == 100 && v.Capacity() == 128);
+        assert(v.Get<0>(42) == 42 && v.Get<1>(42) == 21.0 && v.Get<2>(42) == "42"s);
+
+        // Столбцы непрерывны и передаются в векторные ядра целиком
+        Span<double> halves = v.Column<1>();
+        assert(halves.Size() == 100 && numeric::Sum(halves.Data(), halves.Size()) == 99 * 100 / 4.0);
+        int sum = 0;
+        for (auto [id, half, name] : v) {
+            assert(half == id * 0.5 && name == std::to_string(id));
+            sum += id;
+            half = 0;
+        }
+        assert(sum == 99 * 100 / 2 && v.Get<1>(99) == 0);
+
+        auto [id, half, name] = v[10];
+        name = "ten"s;
+        assert(id == 10 && v.Get<2>(10) == "ten"s);
+
+        v.Erase(v.begin() + 10);
+        assert(v.Size() == 99 && v.Get<0>(10) == 11 && v.Get<2>(10) == "11"s && v.Get<0>(98) == 99);
+
+        const SoaVector<int, double, std::string> copy(v);
+        assert(copy.Size() == 99 && std::get<2>(copy[98]) == "99"s);
+        Span<const int> ids = copy.Column<0>();
+        assert(std::is_sorted(ids.begin(), ids.end()));
+
+        v.Resize(200);
+        assert(v.Size() == 200 && v.Get<0>(199) == 0 && v.Get<2>(199).empty() && v.Get<0>(98) == 99);
+        v.Resize(5);
+        v.PopBack();
+        assert(v.Size() == 4 && v.Capacity() >= 200);
+    }
+    {
+        // Столбец с копированием, которое может выбросить исключение, заставляет копировать и остальные столбцы:
+        // при исключении вектор не меняется
+        struct CopyOnly {
+            explicit CopyOnly(int id)
+                : id(id)
+            {
+            }
+            CopyOnly(const CopyOnly& other)
+                : id(other.id)
+                , throw_on_copy(other.throw_on_copy)
+            {
+                if (throw_on_copy) {
+                    throw std::runtime_error("Oops");
+                }
+            }
+            int id;
+            bool throw_on_copy = false;
+        };
+        SoaVector<std::string, CopyOnly> v;
+        v.Reserve(2);
+        v.EmplaceBack("a"s, 1);
+        v.EmplaceBack("b"s, 2);
+        v.Get<1>(1).throw_on_copy = true;
+        try {
+            v.EmplaceBack("c"s, 3);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 2 && v.Capacity() == 2);
+        assert(v.Get<0>(0) == "a"s && v.Get<0>(1) == "b"s && v.Get<1>(1).id == 2);
+    }
+}
+
+void TestInstrumentation() {
+    using instrumentation::Counter;
+    instrumentation::Reset();
+    {
+        instrumentation::TagScope scope("test_instrumentation");
+        Vector<int> ints;
+        for (int i = 0; i < 100; ++i) {
+            ints.PushBack(i);
+        }
+        ints.Insert(ints.begin() + 90, 0);
+        ints.Erase(ints.begin());
+
+        Vector<std::string> strings;
+        strings.Reserve(2);
+        strings.PushBack("a"s);
+        strings.PushBack("b"s);
+        strings.PushBack("c"s);
+    }
+    Vector<int> untagged(10);
+
+    const instrumentation::Snapshot global = instrumentation::GetSnapshot();
+    std::ostringstream dump;
+    instrumentation::Dump(dump);
+#if defined(VECTOR_INSTRUMENTATION)
+    const instrumentation::Snapshot tagged = instrumentation::GetTagSnapshots().at("test_instrumentation");
+    // Рост 1, 2, 4, ..., 128 и два буфера строк
+    assert(tagged[Counter::ALLOCATIONS] == 8 + 2 && global[Counter::ALLOCATIONS] == tagged[Counter::ALLOCATIONS] + 1);
+    assert(tagged[Counter::DEALLOCATIONS] == tagged[Counter::ALLOCATIONS]);
+    assert(tagged[Counter::BYTES_ALLOCATED] == tagged[Counter::BYTES_FREED]);
+    // Каждый рост заменяет буфер, кроме первого выделения; при переходе 64 -> 128 заняты оба буфера
+    assert(tagged[Counter::REALLOCATIONS] == 7 + 1);
+    assert(tagged[Counter::PEAK_BYTES_IN_USE] == (64 + 128) * sizeof(int));
+    assert(tagged[Counter::ELEMENTS_RELOCATED] == 127 + 1 && tagged[Counter::ELEMENTS_SHIFTED] == 10 + 100);
+    assert(tagged[Counter::ELEMENTS_MOVED] == 2 && tagged[Counter::ELEMENTS_COPIED] == 0);
+    assert(dump.str().find("test_instrumentation allocations=10 ") != std::string::npos);
+#else
+    // Без VECTOR_INSTRUMENTATION счётчики не ведутся
+    for (uint64_t value : global.values) {
+        assert(value == 0);
+    }
+    assert(dump.str().rfind("* allocations=0 ", 0) == 0);
+#endif
+}
+
+void TestStreamingCopy() {
+    // Невыровненные начало и конец приёмника копируются отдельно от потоковой части
+    {
+        std::vector<char> src(1000);
+        std::iota(src.begin(), src.end(), 0);
+        for (size_t offset = 0; offset < 40; ++offset) {
+            for (size_t bytes : { size_t{ 0 }, size_t{ 1 }, size_t{ 31 }, size_t{ 64 }, size_t{ 500 }, size_t{ 959 } }) {
+                std::vector<char> dst(1000, 0);
+                StreamingCopy(dst.data() + offset, src.data() + 1, bytes);
+                assert(std::equal(dst.begin() + offset, dst.begin() + offset + bytes, src.begin() + 1));
+                assert(std::all_of(dst.begin() + offset + bytes, dst.end(), [](char c) { return c == 0; }));
+            }
+        }
+    }
+    assert(UseStreamingCopy(1, StreamingHint::ALWAYS) == IsStreamingCopySupported());
+    assert(!UseStreamingCopy(STREAMING_COPY_THRESHOLD, StreamingHint::NEVER));
+    assert(!UseStreamingCopy(STREAMING_COPY_THRESHOLD - 1, StreamingHint::AUTO));
+    assert(UseStreamingCopy(STREAMING_COPY_THRESHOLD, StreamingHint::AUTO) == IsStreamingCopySupported());
+    {
+        // Больше порога: копирующие конструктор и присваивание выбирают потоковые записи
+        const size_t SIZE = STREAMING_COPY_THRESHOLD / sizeof(double) + 3;
+        Vector<double> v(SIZE);
+        std::iota(v.begin(), v.end(), 0.5);
+        Vector<double> copy(v);
+        assert(copy.Size() == SIZE && std::equal(v.begin(), v.end(), copy.begin()));
+
+        Vector<double> assigned(SIZE * 2);
+        assigned = v;
+        assert(assigned.Size() == SIZE && assigned.Capacity() == SIZE * 2);
+        assert(std::equal(v.begin(), v.end(), assigned.begin()));
+    }
+    {
+        Vector<int> v = { 1, 2, 3, 4, 5 };
+        for (StreamingHint hint : { StreamingHint::AUTO, StreamingHint::ALWAYS, StreamingHint::NEVER }) {
+            Vector<int> small = { 9 };
+            small.CopyFrom(v, hint);
+            assert(small.Size() == 5 && small[4] == 5);
+            Vector<int> large(100);
+            large.CopyFrom(v, hint);
+            assert(large.Size() == 5 && large.Capacity() == 100 && large[0] == 1);
+        }
+        v.CopyFrom(v, StreamingHint::ALWAYS);
+        assert(v.Size() == 5 && v[2] == 3);
+    }
+    {
+        // Для типов, не копируемых побайтово, подсказка не влияет на копирование
+        Obj::ResetCounters();
+        Vector<Obj> v(10);
+        Vector<Obj> copy(3);
+        copy.CopyFrom(v, StreamingHint::ALWAYS);
+        assert(copy.Size() == 10 && Obj::GetAliveObjectCount() == 20);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void TestSharedVector() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        const Obj* data = v.Data();
+        SharedVector<Obj> snapshot(std::move(v));
+        assert(snapshot.Size() == SIZE && snapshot.Data() == data && snapshot.IsUnique());
+
+        // Копии разделяют хранилище, элементы не копируются
+        SharedVector<Obj> copy = snapshot;
+        SharedVector<Obj> another;
+        another = copy;
+        assert(snapshot.UseCount() == 3 && copy.Data() == data && another.Data() == data);
+        assert(Obj::num_copied == 0 && Obj::GetAliveObjectCount() == SIZE);
+
+        // Первое изменение разделённого хранилища копирует элементы один раз
+        copy.EmplaceBack();
+        assert(copy.IsUnique() && copy.Size() == SIZE + 1 && copy.Data() != data);
+        assert(Obj::num_copied == SIZE && snapshot.UseCount() == 2 && snapshot.Size() == SIZE);
+        copy.Mutable()[0].id = 42;
+        assert(Obj::num_copied == SIZE && copy[0].id == 42 && snapshot[0].id != 42);
+
+        // Единственный владелец изменяет хранилище на месте
+        another.Clear();
+        assert(another.Size() == 0 && another.UseCount() == 0 && snapshot.IsUnique());
+        snapshot.PopBack();
+        assert(snapshot.Data() == data && snapshot.Size() == SIZE - 1 && Obj::num_copied == SIZE);
+
+        Vector<Obj> taken = snapshot.Take();
+        assert(taken.Data() == data && snapshot.Size() == 0 && Obj::num_copied == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Копирование при записи со строгой гарантией: при исключении снимок не меняется
+        SharedVector<Obj> snapshot(SIZE);
+        snapshot.Mutable()[SIZE / 2].throw_on_copy = true;
+        SharedVector<Obj> copy = snapshot;
+        try {
+            copy.PushBack(Obj());
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(copy.Size() == SIZE && copy.UseCount() == 2 && copy.Data() == snapshot.Data());
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Дескрипторы одного хранилища копируются и разрушаются из разных потоков
+        SharedVector<int> snapshot = { 1, 2, 3 };
+        std::vector<std::thread> readers;
+        std::atomic<int> sum{ 0 };
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([snapshot, &sum] {
+                for (int i = 0; i < 1000; ++i) {
+                    SharedVector<int> local = snapshot;
+                    sum += local[2];
+                }
+            });
+        }
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        assert(sum == 4 * 1000 * 3 && snapshot.IsUnique());
+        const Vector<int>& elements = snapshot.Get();
+        assert(elements.Size() == 3 && SharedVector<int>().Get().Size() == 0);
+    }
+}
+
+template <typename Lookup>
+void CheckFlatLookup() {
+    // Все позиции lower_bound, включая отсутствующие ключи между существующими и за краями
+    for (int size = 0; size < 40; ++size) {
+        std::vector<int> keys;
+        for (int i = 0; i < size; ++i) {
+            keys.push_back(i * 2 + 1);
+        }
+        FlatSet<int, std::less<int>, Lookup> set(keys.rbegin(), keys.rend());
+        assert(set.Size() == static_cast<size_t>(size));
+        for (int key = -1; key <= size * 2 + 1; ++key) {
+            const size_t expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+            assert(set.LowerBound(key) == expected);
+            assert(set.Contains(key) == (key % 2 != 0 && key > 0 && key < size * 2));
+        }
+    }
+
+    FlatMap<std::string, int, std::less<std::string>, Lookup> map = { { "b", 2 }, { "a", 1 }, { "c", 3 }, { "a", 10 } };
+    assert(map.Size() == 3 && map.At("a") == 1 && map.Find("d") == map.end());
+    map["d"] = 4;
+    assert(map.Erase("b") == 1 && map.Erase("b") == 0);
+    assert(map.Contains("d") && !map.Contains("b") && map.At("c") == 3);
+}
+
+void TestFlatMap() {
+    {
+        // Построение: сортировка и удаление повторов, из повторов остаётся первая пара
+        std::vector<std::pair<int, std::string>> items = { { 5, "five" }, { 1, "one" }, { 3, "three" }, { 1, "uno" } };
+        FlatMap<int, std::string> map(items.begin(), items.end());
+        assert(map.Size() == 3);
+        assert((std::vector<int>(map.Keys().begin(), map.Keys().end()) == std::vector<int>{ 1, 3, 5 }) && map.Values()[0] == "one");
+
+        std::vector<int> keys;
+        for (auto [key, value] : map) {
+            keys.push_back(key);
+            value += "!";
+        }
+        assert((keys == std::vector<int>{ 1, 3, 5 }) && map.At(5) == "five!");
+
+        auto [it, inserted] = map.Emplace(2, 3, 'x');
+        assert(inserted && it.Key() == 2 && it.Value() == "xxx" && map.LowerBound(2) == 1);
+        assert(!map.Emplace(2, "two").second && map.At(2) == "xxx");
+        assert(map.Insert(4, "four") && !map.Insert(4, "cuatro"));
+        map[6] = "six";
+        assert(map.Size() == 6 && map[6] == "six" && map.Find(6).Value() == "six");
+
+        try {
+            map.At(7);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+
+        // Слияние пакета: существующие ключи не перезаписываются
+        std::vector<std::pair<int, std::string>> batch = { { 10, "ten" }, { 0, "zero" }, { 3, "tres" }, { 10, "diez" } };
+        assert(map.InsertMany(batch.begin(), batch.end()) == 2);
+        assert((std::vector<int>(map.Keys().begin(), map.Keys().end()) == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 10 }));
+        assert(map.At(3) == "three!" && map.At(10) == "ten" && map.At(0) == "zero");
+
+        const auto& cmap = map;
+        assert(cmap.Find(0) == cmap.begin() && (*cmap.begin()).second == "zero");
+        map.Clear();
+        assert(map.Size() == 0 && map.Find(1) == map.end());
+    }
+    {
+        // Слияние со строгой гарантией: при исключении копирования контейнер не меняется
+        FlatMap<int, Obj> map;
+        for (int i = 0; i < 10; ++i) {
+            map.Emplace(i * 2, i);
+        }
+        std::vector<std::pair<int, Obj>> batch = { { 3, Obj(3) }, { 5, Obj(5) } };
+        batch[1].second.throw_on_copy = true;
+        try {
+            map.InsertMany(batch.begin(), batch.end());
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(map.Size() == 10 && map.At(18).id == 9 && !map.Contains(3));
+        assert(map.InsertMany(batch.begin(), batch.begin() + 1) == 1 && map.At(3).id == 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        FlatSet<std::string, std::greater<std::string>> set = { "b", "a", "c", "b" };
+        assert(set.Size() == 3 && *set.begin() == "c" && set.Contains("a"));
+        assert(set.Insert("d") && !set.Insert("a") && *set.begin() == "d");
+        std::vector<std::string> batch = { "e", "a", "f", "e" };
+        assert(set.InsertMany(batch.begin(), batch.end()) == 2);
+        const std::vector<std::string> expected = { "f", "e", "d", "c", "b", "a" };
+        assert(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+        assert(set.Erase("c") == 1 && set.Erase("c") == 0 && set.Find("c") == set.end());
+    }
+    CheckFlatLookup<BinaryLookup>();
+    CheckFlatLookup<BranchlessLookup>();
+    CheckFlatLookup<EytzingerLookup>();
+    {
+        // Индекс Эйтцингера перестраивается после каждого изменения ключей
+        FlatSet<int, std::less<int>, EytzingerLookup> set;
+        for (int i = 100; i > 0; --i) {
+            set.Insert(i * 3);
+        }
+        assert(set.Size() == 100 && set.Contains(150) && !set.Contains(151) && set.LowerBound(151) == 50);
+        std::vector<int> batch = { 151, 1, 1000 };
+        set.InsertMany(batch.begin(), batch.end());
+        assert(set.LowerBound(151) == 51 && set.LowerBound(2000) == 103 && set.Contains(1));
+        FlatSet<int, std::less<int>, EytzingerLookup> copy = set;
+        set.Clear();
+        assert(!set.Contains(1) && copy.Contains(1000));
+    }
+}
+
+void TestGapVector() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        GapVector<Obj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE && v.GapPosition() == SIZE && Obj::GetAliveObjectCount() == SIZE);
+
+        // Вставки у курсора: разрыв переносится один раз, дальше элементы не перемещаются
+        auto cursor = v.begin() + SIZE / 2;
+        v.Reserve(2 * SIZE);
+        int moved = Obj::num_moved;
+        for (int i = 0; i < 10; ++i) {
+            cursor = v.Emplace(cursor, 1000 + i) + 1;
+        }
+        // SIZE / 2 элементов переносятся через разрыв, ещё одно перемещение - первого вставленного элемента
+        assert(Obj::num_moved - moved == static_cast<int>(SIZE / 2 + 1) && v.Size() == SIZE + 10 && v.GapPosition() == SIZE / 2 + 10);
+        assert(v[SIZE / 2].id == 1000 && v[SIZE / 2 + 9].id == 1009 && v[SIZE / 2 + 10].id == static_cast<int>(SIZE / 2));
+        assert(v[0].id == 0 && v[SIZE + 9].id == static_cast<int>(SIZE - 1));
+
+        // Удаление за курсором поглощается разрывом
+        moved = Obj::num_moved;
+        v.Erase(v.begin() + SIZE / 2 + 10, v.begin() + SIZE / 2 + 15);
+        assert(Obj::num_moved == moved && v.Size() == SIZE + 5 && v[SIZE / 2 + 10].id == static_cast<int>(SIZE / 2 + 5));
+
+        // Перенос разрыва в начало и индексация по обе стороны разрыва
+        v.Insert(v.cbegin(), Obj(-1));
+        assert(v.GapPosition() == 1 && v[0].id == -1 && v[1].id == 0 && v[SIZE + 5].id == static_cast<int>(SIZE - 1));
+        v.PopBack();
+        assert(v.Size() == SIZE + 5 && v.GapPosition() == SIZE + 5 && v[SIZE + 4].id == static_cast<int>(SIZE - 2));
+
+        // Итераторы произвольного доступа работают с алгоритмами стандартной библиотеки
+        assert(std::distance(v.cbegin(), v.cend()) == static_cast<std::ptrdiff_t>(v.Size()));
+        assert(std::is_sorted(v.begin() + SIZE / 2 + 11, v.end(), [](const Obj& lhs, const Obj& rhs) {
+            return lhs.id < rhs.id;
+        }));
+        assert(std::find_if(v.begin(), v.end(), [](const Obj& obj) { return obj.id == 1003; }) - v.begin() == SIZE / 2 + 4);
+
+        // Compact: копия или перенос в непрерывный Vector
+        const size_t alive = static_cast<size_t>(Obj::GetAliveObjectCount());
+        Vector<Obj> copy = v.Compact();
+        assert(copy.Size() == v.Size() && static_cast<size_t>(Obj::GetAliveObjectCount()) == alive + v.Size());
+        const size_t size = v.Size();
+        Vector<Obj> compact = std::move(v).Compact();
+        assert(compact.Size() == size && v.Size() == 0 && static_cast<size_t>(Obj::GetAliveObjectCount()) == alive + size);
+        for (size_t i = 0; i < size; ++i) {
+            assert(compact[i].id == copy[i].id);
+        }
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Сверка с std::vector при случайных вставках и удалениях
+        GapVector<std::string> v;
+        std::vector<std::string> expected;
+        unsigned state = 1;
+        for (int i = 0; i < 2000; ++i) {
+            state = state * 1103515245u + 12345u;
+            const size_t pos = expected.empty() ? 0 : (state >> 8) % (expected.size() + 1);
+            if (expected.empty() || (state >> 4) % 3 != 0) {
+                // Аргумент ссылается на элемент самого контейнера
+                const std::string value = expected.empty() ? std::to_string(i) : expected[pos % expected.size()] + "+";
+                v.Insert(v.cbegin() + pos, expected.empty() ? value : v[pos % v.Size()] + "+");
+                expected.insert(expected.begin() + pos, value);
+            }
+            else {
+                const size_t erase_pos = pos % expected.size();
+                v.Erase(v.cbegin() + erase_pos);
+                expected.erase(expected.begin() + erase_pos);
+            }
+        }
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        GapVector<std::string> copy = v;
+        v.Clear();
+        assert(v.Size() == 0 && std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()));
+        try {
+            copy.Erase(copy.cbegin() + copy.Size() + 1);
+            assert(false);
+        }
+        catch (const std::range_error&) {
+        }
+    }
+    {
+        GapVector<int> v = { 1, 2, 3 };
+        v.Insert(v.cbegin() + 1, v[2]);
+        Vector<int> compact = std::move(v).Compact();
+        assert((std::vector<int>(compact.begin(), compact.end()) == std::vector<int>{ 1, 3, 2, 3 }));
+    }
+}
+
+void TestStaticVector() {
+    // Для тривиальных типов копирование тривиально, элементы хранятся внутри объекта
+    static_assert(std::is_trivially_copyable_v<StaticVector<int, 8>>);
+    static_assert(!std::is_trivially_copyable_v<StaticVector<std::string, 8>>);
+    static_assert(sizeof(StaticVector<int, 8>) == 8 * sizeof(int) + sizeof(size_t));
+    static_assert(StaticVector<int, 8>::Capacity() == 8);
+
+    const size_t SIZE = 16;
+    {
+        StaticVector<int, SIZE> v = { 1, 2, 3 };
+        StaticVector<int, SIZE> copy = v;
+        v[0] = 10;
+        assert(copy.Size() == 3 && copy[0] == 1 && v[0] == 10);
+        v.Resize(SIZE);
+        assert(v.Size() == SIZE && v[SIZE - 1] == 0);
+
+        // THROW: исключение std::length_error, контейнер не меняется
+        try {
+            v.PushBack(4);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+        try {
+            v.Resize(SIZE + 1);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+        assert(v.Size() == SIZE && v[0] == 10);
+        assert(!v.TryPushBack(4) && v.TryEmplaceBack(4) == nullptr && v.Size() == SIZE);
+        v.PopBack();
+        assert(v.TryPushBack(4) && v[SIZE - 1] == 4);
+
+        StaticVector<int, 4, StaticOverflow::ASSERT> checked(4);
+        assert(!checked.TryPushBack(1) && checked.Size() == 4);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            StaticVector<Obj, SIZE> v;
+            for (int i = 0; i < 5; ++i) {
+                assert(v.TryEmplaceBack(i)->id == i);
+            }
+            v.Emplace(v.cbegin() + 1, 100);
+            v.Insert(v.cend(), Obj(200));
+            v.Emplace(v.cbegin(), v[2]);
+            assert(v.Size() == 8 && v[0].id == 1 && v[1].id == 0 && v[2].id == 100 && v[7].id == 200);
+            v.Erase(v.cbegin() + 2);
+            v.Erase(v.cbegin(), v.cbegin() + 2);
+            assert(v.Size() == 5 && v[0].id == 1 && v[4].id == 200);
+            assert(Obj::GetAliveObjectCount() == 5);
+
+            StaticVector<Obj, SIZE> copy = v;
+            StaticVector<Obj, SIZE> moved = std::move(copy);
+            assert(copy.Size() == 0 && moved.Size() == 5 && Obj::GetAliveObjectCount() == 10);
+            StaticVector<Obj, SIZE> other(2);
+            other.Swap(moved);
+            assert(other.Size() == 5 && other[4].id == 200 && moved.Size() == 2);
+            other = moved;
+            assert(other.Size() == 2 && Obj::GetAliveObjectCount() == 9);
+            moved = std::move(v);
+            assert(moved.Size() == 5 && v.Size() == 0 && Obj::GetAliveObjectCount() == 7);
+
+            // Исключение при копировании оставляет контейнер корректным
+            moved[1].throw_on_copy = true;
+            try {
+                StaticVector<Obj, SIZE> failed = moved;
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(Obj::GetAliveObjectCount() == 7);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
 }
 
 struct C {
@@ -674,6 +2514,32 @@ void TestVector() {
         RUN_TEST(test_vector::TestResizePushPopBack);
         RUN_TEST(test_vector::TestEmplaceBack);
         RUN_TEST(test_vector::TestInsertEmplace);
+        RUN_TEST(test_vector::TestTriviallyRelocatable);
+        RUN_TEST(test_vector::TestAllocator);
+        RUN_TEST(test_vector::TestReallocGrowth);
+        RUN_TEST(test_vector::TestSmallVector);
+        RUN_TEST(test_vector::TestGrowthPolicy);
+        RUN_TEST(test_vector::TestRangeOperations);
+        RUN_TEST(test_vector::TestEraseRange);
+        RUN_TEST(test_vector::TestDefaultInit);
+        RUN_TEST(test_vector::TestAlignment);
+        RUN_TEST(test_vector::TestHugePageAllocator);
+#if !defined(_WIN32)
+        RUN_TEST(test_vector::TestMappedVector);
+#endif
+        RUN_TEST(test_vector::TestSerialization);
+        RUN_TEST(test_vector::TestNumericKernels);
+        RUN_TEST(test_vector::TestParallel);
+        RUN_TEST(test_vector::TestConcurrentVector);
+        RUN_TEST(test_vector::TestSegmentedVector);
+        RUN_TEST(test_vector::TestIncrementalGrowth);
+        RUN_TEST(test_vector::TestSoaVector);
+        RUN_TEST(test_vector::TestInstrumentation);
+        RUN_TEST(test_vector::TestStreamingCopy);
+        RUN_TEST(test_vector::TestSharedVector);
+        RUN_TEST(test_vector::TestFlatMap);
+        RUN_TEST(test_vector::TestGapVector);
+        RUN_TEST(test_vector::TestStaticVector);
         RUN_TEST(test_vector::Benchmark);
     }
     catch (const std::exception& e) {
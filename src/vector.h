@@ -1,34 +1,126 @@
 #pragma once
 
+#include "growth_policy.h"
 #include "raw_memory.h"
+#include "streaming_copy.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
 #include <memory>
+#include <ostream>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+// Категория итератора; для типов, не являющихся итераторами, подстановка завершается неудачей
+template <typename It>
+using IteratorCategory = typename std::iterator_traits<It>::iterator_category;
+
+template <typename It>
+inline constexpr bool IsForwardIteratorV = std::is_convertible_v<IteratorCategory<It>, std::forward_iterator_tag>;
+
+// Тег конструктора, инициализирующего элементы по умолчанию: тривиальные типы остаются неинициализированными
+struct DefaultInit {
+    explicit DefaultInit() = default;
+};
+
+inline constexpr DefaultInit default_init{};
+
+// Заголовок двоичного представления вектора. Числа записываются в порядке байтов платформы
+struct VectorStreamHeader {
+    static constexpr uint32_t MAGIC = 0x52544356;  // "VCTR"
+
+    uint32_t magic = MAGIC;
+    uint32_t is_block = 0;  // 1 — элементы записаны одним блоком байт, 0 — поэлементным кодеком
+    uint64_t element_size = 0;
+    uint64_t size = 0;
+};
+
+// Поэлементный кодек для типов, не являющихся тривиально копируемыми.
+// Специализация предоставляет static void Write(std::ostream&, const T&) и static T Read(std::istream&)
 template <typename T>
-class Vector {
+struct VectorCodec;
+
+template <>
+struct VectorCodec<std::string> {
+    static void Write(std::ostream& out, const std::string& value) {
+        const uint64_t length = value.size();
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(value.data(), static_cast<std::streamsize>(length));
+    }
+
+    static std::string Read(std::istream& in) {
+        uint64_t length = 0;
+        in.read(reinterpret_cast<char*>(&length), sizeof(length));
+        std::string value(in ? length : 0, '\0');
+        in.read(value.data(), static_cast<std::streamsize>(value.size()));
+        if (!in) {
+            throw std::runtime_error("Unexpected end of Vector stream");
+        }
+        return value;
+    }
+};
+
+// Состояние постепенного переноса элементов. Для политик роста без переноса базовый класс пуст и не занимает места
+template <typename T, typename Allocator, bool Incremental>
+class VectorMigration {
+};
+
+template <typename T, typename Allocator>
+class VectorMigration<T, Allocator, true> {
+protected:
+    // Буфер, из которого ещё переносятся элементы [migrated_, old_data_.Capacity())
+    RawMemory<T, Allocator> old_data_;
+    size_t migrated_ = 0;
+    size_t migration_step_ = 0;
+};
+
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class Vector : private VectorMigration<T, Allocator, (MigrationStepV<GrowthPolicy> > 0)> {
+    // Сколько старых элементов переносится за одно добавление в режиме IncrementalGrowth, 0 — режим выключен
+    static constexpr size_t MIGRATION_STEP = MigrationStepV<GrowthPolicy>;
+    static constexpr bool INCREMENTAL = MIGRATION_STEP > 0;
+
+    static_assert(!INCREMENTAL || IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>,
+        "IncrementalGrowth requires a nothrow move constructible or trivially relocatable type");
+
 public:
 // ---------- Iterator --------------------------------------------------------
+    using allocator_type = Allocator;
     using iterator = T*;
     using const_iterator = const T*;
 
+    // Итераторы и Data() требуют непрерывного буфера. Неконстантные завершают постепенный перенос элементов,
+    // константные ничего не изменяют и требуют завершённого переноса: константный объект могут одновременно
+    // читать несколько потоков. Во время переноса элементы читаются через operator[]
     iterator begin() noexcept {
+        FinishMigration();
         return data_.GetAddress();
     }
 
     iterator end() noexcept {
+        FinishMigration();
         return data_.GetAddress() + size_;
     }
 
     const_iterator begin() const noexcept {
+        assert(!IsMigrating());
         return data_.GetAddress();
     }
 
     const_iterator end() const noexcept {
+        assert(!IsMigrating());
         return data_.GetAddress() + size_;
     }
 
@@ -44,25 +136,87 @@ public:
 // ---------- Vector ----------------------------------------------------------
     Vector() = default;
 
-    explicit Vector(size_t size)
-        : data_(size)
+    explicit Vector(const Allocator& alloc)
+        : data_(alloc)
+    {
+    }
+
+    explicit Vector(size_t size, const Allocator& alloc = Allocator())
+        : data_(size, alloc)
         , size_(size)
     {
         std::uninitialized_value_construct_n(data_.GetAddress(), size);
     }
 
+    Vector(size_t size, DefaultInit, const Allocator& alloc = Allocator())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        std::uninitialized_default_construct_n(data_.GetAddress(), size);
+    }
+
     Vector(const Vector& other)
-        : data_(other.size_)
+        : Vector(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.GetAllocator()))
+    {
+    }
+
+    Vector(const Vector& other, const Allocator& alloc)
+        : Vector(other, alloc, StreamingHint::AUTO)
+    {
+    }
+
+    // Копирование с явным выбором потоковых записей для тривиально копируемых типов (streaming_copy.h)
+    Vector(const Vector& other, const Allocator& alloc, StreamingHint hint)
+        : data_(other.size_, alloc)
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+        // other не изменяется: во время переноса его элементы копируются из обоих буферов
+        T* buff_to = data_.GetAddress();
+        try {
+            other.VisitParts([&buff_to, hint](const T* buff_from, size_t count) {
+                UninitializedCopy(buff_from, count, buff_to, hint);
+                buff_to += count;
+            });
+        }
+        catch (...) {
+            std::destroy(data_.GetAddress(), buff_to);
+            throw;
+        }
+    }
+
+    Vector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : data_(init.size(), alloc)
+        , size_(init.size())
+    {
+        std::uninitialized_copy_n(init.begin(), init.size(), data_.GetAddress());
+    }
+
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    Vector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : data_(alloc)
+    {
+        Append(first, last);
     }
 
     Vector& operator= (const Vector& other) {
+        CopyFrom(other);
+        return *this;
+    }
+
+    // Аналог копирующего присваивания. Тривиально копируемые элементы копируются целиком потоковыми записями
+    // в обход кэша, если так решает hint: по умолчанию для копий от STREAMING_COPY_THRESHOLD байт
+    void CopyFrom(const Vector& other, StreamingHint hint = StreamingHint::AUTO) {
         if (this != &other) {
-            if (other.size_ > data_.Capacity()) {
-                Vector tmp(other);
-                Swap(tmp);
+            FinishMigration();
+            if (other.size_ > data_.Capacity() || other.IsMigrating()) {
+                // Аллокатор остаётся прежним, копируются только элементы
+                Vector tmp(other, GetAllocator(), hint);
+                ReplaceBuffer(tmp.data_);
+                std::swap(size_, tmp.size_);
+            }
+            else if constexpr (std::is_trivially_copyable_v<T>) {
+                CopyBytes(data_.GetAddress(), other.data_.GetAddress(), other.size_ * sizeof(T), hint);
+                size_ = other.size_;
             }
             else {
                 size_t min_size = std::min(size_, other.size_);
@@ -78,7 +232,6 @@ public:
                 size_ = other.size_;
             }
         }
-        return *this;
     }
 
     Vector(Vector&& other) noexcept {
@@ -87,6 +240,8 @@ public:
 
     Vector& operator= (Vector&& other) noexcept {
         if (this != &other) {
+            FinishMigration();
+            other.FinishMigration();
             data_ = std::move(other.data_);
 
             size_ = other.size_;
@@ -95,19 +250,25 @@ public:
         return *this;
     }
 
-    //     ,     
+    // Резервирование памяти под элементы вектора, когда известно их примерное количество
     void Reserve(size_t new_capacity) {
+        FinishMigration();
         if (new_capacity <= data_.Capacity()) {
             return;
         }
+        if constexpr (RawMemory<T, Allocator>::CAN_REALLOCATE) {
+            data_.Reallocate(new_capacity);
+            return;
+        }
 
-        RawMemory<T> new_data(new_capacity);
+        RawMemory<T, Allocator> new_data(new_capacity, GetAllocator());
         SelectUninitializedMoveOrCopyWhole(new_data);
 
-        data_.Swap(new_data);
+        ReplaceBuffer(new_data);
     }
 
     ~Vector() {
+        FinishMigration();
         std::destroy_n(data_.GetAddress(), size_);
     }
 
@@ -119,21 +280,70 @@ public:
         return data_.Capacity();
     }
 
+    const Allocator& GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
     const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
+    // Во время постепенного переноса ещё не перенесённые элементы читаются из старого буфера
     T& operator[](size_t index) noexcept {
         assert(index < size_);
+        if constexpr (INCREMENTAL) {
+            if (index >= this->migrated_ && index < this->old_data_.Capacity()) {
+                return this->old_data_[index];
+            }
+        }
         return data_[index];
     }
 
+    // Выполняется ли постепенный перенос элементов в новый буфер (только для IncrementalGrowth)
+    bool IsMigrating() const noexcept {
+        if constexpr (INCREMENTAL) {
+            return this->old_data_.Capacity() != 0;
+        }
+        else {
+            return false;
+        }
+    }
+
+    // Переносит все оставшиеся элементы, после чего доступны константные итераторы и Data()
+    void FinishMigration() noexcept {
+        if constexpr (INCREMENTAL) {
+            if (IsMigrating()) {
+                Migrate(this->old_data_.Capacity());
+            }
+        }
+    }
+
+    // Вызывает visit(first, count) для непрерывных частей элементов по порядку, не изменяя вектор.
+    // Во время переноса частей до трёх: элементы [migrated_, old_data_.Capacity()) ещё находятся в старом буфере,
+    // остальные — в новом. Так константный вектор читается целиком, пока константные итераторы недоступны
+    template <typename Visit>
+    void VisitParts(Visit visit) const {
+        if constexpr (INCREMENTAL) {
+            if (IsMigrating()) {
+                const size_t old_size = this->old_data_.Capacity();
+                visit(data_.GetAddress(), this->migrated_);
+                visit(this->old_data_ + this->migrated_, old_size - this->migrated_);
+                visit(data_ + old_size, size_ - old_size);
+                return;
+            }
+        }
+        visit(data_.GetAddress(), size_);
+    }
+
     void Swap(Vector& other) noexcept {
+        FinishMigration();
+        other.FinishMigration();
         data_.Swap(other.data_);
         std::swap(size_, other.size_);
     }
 
     void Resize(size_t new_size) {
+        FinishMigration();
         if (new_size < size_) {
             std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
         }
@@ -144,20 +354,87 @@ public:
         size_ = new_size;
     }
 
+    // Аналог Resize, но новые элементы инициализируются по умолчанию: у тривиальных типов память не заполняется
+    void ResizeDefaultInit(size_t new_size) {
+        FinishMigration();
+        if (new_size < size_) {
+            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+        }
+        else {
+            Reserve(new_size);
+            std::uninitialized_default_construct_n(data_.GetAddress() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    // Небезопасное изменение размера для типов без конструктора и деструктора: новые элементы не инициализируются
+    // и должны быть перезаписаны через возвращаемый указатель (или Data()) до чтения
+    T* ResizeForOverwrite(size_t new_size) {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+            "ResizeForOverwrite requires a trivial type");
+        FinishMigration();
+        Reserve(new_size);
+        T* first_new = data_.GetAddress() + std::min(size_, new_size);
+        size_ = new_size;
+        return first_new;
+    }
+
+    // Аналог Resize, в котором новые элементы создаёт вызов construct(first, count) в неинициализированной памяти.
+    // construct либо создаёт все count элементов, либо выбрасывает исключение, разрушив уже созданные
+    template <typename Construct>
+    void ResizeWith(size_t new_size, Construct construct) {
+        FinishMigration();
+        if (new_size < size_) {
+            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+        }
+        else {
+            Reserve(new_size);
+            construct(data_.GetAddress() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    T* Data() noexcept {
+        FinishMigration();
+        return data_.GetAddress();
+    }
+
+    const T* Data() const noexcept {
+        assert(!IsMigrating());
+        return data_.GetAddress();
+    }
+
     template <typename... Args>
     void PushBack(Args&&... args) {
         EmplaceBack(std::forward<Args>(args)...);
     }
 
+    void Clear() noexcept {
+        FinishMigration();
+        std::destroy_n(data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
     void PopBack() noexcept {
+        FinishMigration();
         std::destroy_at(data_ + size_ - 1);
         --size_;
     }
 
     template <typename... Args>
     T& EmplaceBack(Args&&... args) {
+        if constexpr (INCREMENTAL) {
+            return EmplaceBackIncremental(std::forward<Args>(args)...);
+        }
+        if constexpr (RawMemory<T, Allocator>::CAN_REALLOCATE) {
+            if (size_ == data_.Capacity()) {
+                GrowInPlaceAndInsert(size_, std::forward<Args>(args)...);
+                ++size_;
+                return *(data_ + size_ - 1);
+            }
+        }
         if (size_ == data_.Capacity()) {
-            RawMemory<T> new_data((size_ == 0) ? 1 : size_ * 2);
+            RawMemory<T, Allocator> new_data(NextCapacity(), GetAllocator());
             new (new_data + size_) T(std::forward<Args>(args)...);
             // ----------------------------------------------------------------
             try {
@@ -168,7 +445,7 @@ public:
                 throw;
             }
             // ----------------------------------------------------------------
-            data_.Swap(new_data);
+            ReplaceBuffer(new_data);
         }
         else {
             new (data_ + size_) T(std::forward<Args>(args)...);
@@ -184,32 +461,54 @@ public:
         }
         size_t shift = pos - begin();
 
+        if constexpr (RawMemory<T, Allocator>::CAN_REALLOCATE) {
+            if (size_ == data_.Capacity()) {
+                GrowInPlaceAndInsert(shift, std::forward<Args>(args)...);
+                ++size_;
+                return data_ + shift;
+            }
+        }
         if (size_ == data_.Capacity()) {
-            RawMemory<T> new_data((size_ == 0) ? 1 : size_ * 2);
+            RawMemory<T, Allocator> new_data(NextCapacity(), GetAllocator());
             new (new_data + shift) T(std::forward<Args>(args)...);
-            // ----------------------------------------------------------------
-            try {
-                SelectUninitializedMoveOrCopy(data_.GetAddress(), shift, new_data.GetAddress());
-            }
-            catch (...) {
-                std::destroy_at(new_data + shift);
-                throw;
+            if constexpr (IsTriviallyRelocatableV<T>) {
+                RelocateBytes(data_.GetAddress(), shift, new_data.GetAddress());
+                RelocateBytes(data_.GetAddress() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
             }
-            // ----------------------------------------------------------------
-            try {
-                SelectUninitializedMoveOrCopy(data_.GetAddress() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
-            }
-            catch (...) {
-                std::destroy_n(new_data.GetAddress(), shift + 1);
-                throw;
+            else {
+                // ------------------------------------------------------------
+                try {
+                    SelectUninitializedMoveOrCopy(data_.GetAddress(), shift, new_data.GetAddress());
+                }
+                catch (...) {
+                    std::destroy_at(new_data + shift);
+                    throw;
+                }
+                // ------------------------------------------------------------
+                try {
+                    SelectUninitializedMoveOrCopy(data_.GetAddress() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
+                }
+                catch (...) {
+                    std::destroy_n(new_data.GetAddress(), shift + 1);
+                    throw;
+                }
+                // ------------------------------------------------------------
+                std::destroy_n(data_.GetAddress(), size_);
             }
-            // ----------------------------------------------------------------
-            std::destroy_n(data_.GetAddress(), size_);
-            data_.Swap(new_data);
+            ReplaceBuffer(new_data);
+        }
+        else if constexpr (IsTriviallyRelocatableV<T>) {
+            // Элемент создаётся во временном буфере до сдвига, так как аргументы могут ссылаться на элементы вектора
+            alignas(T) std::byte cp_value[sizeof(T)];
+            new (cp_value) T(std::forward<Args>(args)...);
+            ShiftBytes(data_ + shift, size_ - shift, data_ + shift + 1);
+            RelocateBytes(reinterpret_cast<T*>(cp_value), 1, data_ + shift);
         }
         else {
-            if (size_ != 0) {
+            // Вставка в конец не сдвигает элементы: сдвиг перезаписал бы перенесённый последний элемент
+            if (shift < size_) {
                 size_t min_size = size_ - 1;
+                VECTOR_COUNT(ELEMENTS_SHIFTED, size_ - shift);
                 T cp_value = T(std::forward<Args>(args)...);
                 new (data_ + size_) T(std::move(data_[min_size]));
                 std::move_backward(data_ + shift, data_ + min_size, data_ + size_);
@@ -224,11 +523,18 @@ public:
     }
 
 iterator Erase(const_iterator pos) {
-    if (pos < begin() || pos > end()) {
+    if (pos < begin() || pos >= end()) {
         throw std::range_error("Pos value is outside the Vector");
     }
     size_t shift = pos - begin();
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        std::destroy_at(data_ + shift);
+        ShiftBytes(data_ + shift + 1, size_ - shift - 1, data_ + shift);
+        --size_;
+        return data_ + shift;
+    }
     if (size_ > (shift + 1)) {
+        VECTOR_COUNT(ELEMENTS_SHIFTED, size_ - shift - 1);
         std::move(data_ + shift + 1, data_ + size_, data_ + shift);
     }
     std::destroy_at(data_ + size_ - 1);
@@ -236,6 +542,73 @@ iterator Erase(const_iterator pos) {
     return data_ + shift;
 }
 
+    // Удаляет элементы [first, last), сдвигая хвост один раз
+    iterator Erase(const_iterator first, const_iterator last) {
+        if (first < begin() || last > end() || first > last) {
+            throw std::range_error("Range is outside the Vector");
+        }
+        size_t shift = first - begin();
+        size_t count = last - first;
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            std::destroy_n(data_ + shift, count);
+            ShiftBytes(data_ + shift + count, size_ - shift - count, data_ + shift);
+        }
+        else {
+            VECTOR_COUNT(ELEMENTS_SHIFTED, size_ - shift - count);
+            std::move(data_ + shift + count, data_ + size_, data_ + shift);
+            std::destroy_n(data_ + size_ - count, count);
+        }
+        size_ -= count;
+        return data_ + shift;
+    }
+
+    // Удаляет все элементы, для которых pred возвращает true, за один проход и возвращает их количество.
+    // Сохраняет порядок оставшихся элементов
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        FinishMigration();
+        size_t old_size = size_;
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            T* data = data_.GetAddress();
+            size_t write = 0;
+            size_t read = 0;
+            try {
+                while (read < size_) {
+                    // Подряд идущие оставшиеся элементы переносятся одним вызовом memmove
+                    size_t run = read;
+                    while (run < size_ && !pred(std::as_const(data[run]))) {
+                        ++run;
+                    }
+                    if (write != read) {
+                        ShiftBytes(data + read, run - read, data + write);
+                    }
+                    write += run - read;
+                    read = run;
+                    if (read < size_) {
+                        std::destroy_at(data + read);
+                        ++read;
+                    }
+                }
+            }
+            catch (...) {
+                // Непроверенный остаток переносится к уже сжатой части, чтобы не оставить разрывов
+                ShiftBytes(data + read, size_ - read, data + write);
+                size_ = write + (size_ - read);
+                throw;
+            }
+            size_ = write;
+        }
+        else {
+            iterator new_end = std::remove_if(begin(), end(), [&pred](const T& value) {
+                return pred(value);
+            });
+            size_t new_size = new_end - begin();
+            std::destroy_n(new_end, size_ - new_size);
+            size_ = new_size;
+        }
+        return old_size - size_;
+    }
+
     iterator Insert(const_iterator pos, const T& value) {
         return Emplace(pos, value);
     }
@@ -244,22 +617,458 @@ iterator Erase(const_iterator pos) {
         return Emplace(pos, std::move(value));
     }
 
+    // Вставляет count копий value. Для прямых итераторов и вставки копий память перераспределяется
+    // не более одного раза, а хвост вектора сдвигается не более одного раза
+    iterator Insert(const_iterator pos, size_t count, const T& value) {
+        FinishMigration();
+        size_t shift = CheckedShift(pos);
+        // Значение копируется заранее, так как может ссылаться на элемент вектора
+        T cp_value(value);
+        return InsertWith(shift, count,
+            [&cp_value](T* buff_to, size_t /*from*/, size_t dist) {
+                std::uninitialized_fill_n(buff_to, dist, cp_value);
+            },
+            [&cp_value](T* buff_to, size_t /*from*/, size_t dist) {
+                std::fill_n(buff_to, dist, cp_value);
+            });
+    }
+
+    // Вставляет элементы диапазона [first, last), который не должен ссылаться на элементы самого вектора
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+        FinishMigration();
+        size_t shift = CheckedShift(pos);
+        if constexpr (IsForwardIteratorV<InputIt>) {
+            using Distance = typename std::iterator_traits<InputIt>::difference_type;
+            return InsertWith(shift, static_cast<size_t>(std::distance(first, last)),
+                [first](T* buff_to, size_t from, size_t dist) {
+                    std::uninitialized_copy_n(std::next(first, static_cast<Distance>(from)), dist, buff_to);
+                },
+                [first](T* buff_to, size_t from, size_t dist) {
+                    std::copy_n(std::next(first, static_cast<Distance>(from)), dist, buff_to);
+                });
+        }
+        else {
+            // Длина входного диапазона заранее неизвестна: элементы добавляются в конец и поворачиваются на место
+            size_t old_size = size_;
+            Append(first, last);
+            std::rotate(begin() + shift, begin() + old_size, end());
+            return begin() + shift;
+        }
+    }
+
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    void Append(InputIt first, InputIt last) {
+        if constexpr (IsForwardIteratorV<InputIt>) {
+            Insert(end(), first, last);
+        }
+        else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    // Заменяет содержимое вектора элементами диапазона [first, last)
+    template <typename InputIt, typename = IteratorCategory<InputIt>>
+    void Assign(InputIt first, InputIt last) {
+        FinishMigration();
+        if constexpr (IsForwardIteratorV<InputIt>) {
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count > data_.Capacity()) {
+                RawMemory<T, Allocator> new_data(count, GetAllocator());
+                std::uninitialized_copy_n(first, count, new_data.GetAddress());
+                std::destroy_n(data_.GetAddress(), size_);
+                ReplaceBuffer(new_data);
+            }
+            else if (count <= size_) {
+                std::copy_n(first, count, data_.GetAddress());
+                std::destroy_n(data_ + count, size_ - count);
+            }
+            else {
+                InputIt mid = std::next(first, static_cast<typename std::iterator_traits<InputIt>::difference_type>(size_));
+                std::copy(first, mid, data_.GetAddress());
+                std::uninitialized_copy(mid, last, data_ + size_);
+            }
+            size_ = count;
+        }
+        else {
+            Clear();
+            Append(first, last);
+        }
+    }
+
+    void Assign(std::initializer_list<T> init) {
+        Assign(init.begin(), init.end());
+    }
+
+// ---------- Serialization ---------------------------------------------------
+    // Размер фрагмента, которым данные читаются прямо в зарезервированную память вектора
+    static constexpr size_t IO_CHUNK_BYTES = 1024 * 1024;
+
+    // Записывает заголовок и элементы: тривиально копируемые — одним блоком, остальные — кодеком Codec
+    template <typename Codec = VectorCodec<T>>
+    void WriteTo(std::ostream& out) const {
+        const VectorStreamHeader header = MakeStreamHeader();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        VisitParts([&out](const T* values, size_t count) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) {
+                    Codec::Write(out, values[i]);
+                }
+            }
+        });
+        if (!out) {
+            throw std::runtime_error("Cannot write Vector");
+        }
+    }
+
+    // Заменяет содержимое вектора прочитанным из потока. Предоставляет строгую гарантию безопасности исключений
+    template <typename Codec = VectorCodec<T>>
+    void ReadFrom(std::istream& in) {
+        VectorStreamHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        CheckStreamHeader(in ? header : VectorStreamHeader{ 0 });
+
+        Vector tmp(GetAllocator());
+        tmp.Reserve(static_cast<size_t>(std::min<uint64_t>(header.size, ChunkElements())));
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            while (tmp.size_ < header.size) {
+                const size_t count = std::min<size_t>(header.size - tmp.size_, ChunkElements());
+                tmp.ReserveForRead(count, header.size);
+                const auto bytes = static_cast<std::streamsize>(count * sizeof(T));
+                in.read(reinterpret_cast<char*>(tmp.data_ + tmp.size_), bytes);
+                if (in.gcount() != bytes) {
+                    throw std::runtime_error("Unexpected end of Vector stream");
+                }
+                tmp.size_ += count;
+            }
+        }
+        else {
+            for (uint64_t i = 0; i < header.size; ++i) {
+                tmp.EmplaceBack(Codec::Read(in));
+            }
+        }
+        Swap(tmp);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Варианты для файлового дескриптора, только для тривиально копируемых типов
+    void WriteTo(int fd) const {
+        static_assert(std::is_trivially_copyable_v<T>, "Descriptor I/O requires a trivially copyable type");
+        const VectorStreamHeader header = MakeStreamHeader();
+        WriteAll(fd, &header, sizeof(header));
+        VisitParts([fd](const T* values, size_t count) {
+            WriteAll(fd, values, count * sizeof(T));
+        });
+    }
+
+    void ReadFrom(int fd) {
+        static_assert(std::is_trivially_copyable_v<T>, "Descriptor I/O requires a trivially copyable type");
+        VectorStreamHeader header;
+        CheckStreamHeader(ReadAll(fd, &header, sizeof(header)) == sizeof(header) ? header : VectorStreamHeader{ 0 });
+
+        Vector tmp(GetAllocator());
+        while (tmp.size_ < header.size) {
+            const size_t count = std::min<size_t>(header.size - tmp.size_, ChunkElements());
+            tmp.ReserveForRead(count, header.size);
+            if (ReadAll(fd, tmp.data_ + tmp.size_, count * sizeof(T)) != count * sizeof(T)) {
+                throw std::runtime_error("Unexpected end of Vector stream");
+            }
+            tmp.size_ += count;
+        }
+        Swap(tmp);
+    }
+#endif
+
 private:
+    static constexpr size_t ChunkElements() noexcept {
+        return std::max<size_t>(IO_CHUNK_BYTES / sizeof(T), 1);
+    }
+
+    // Размер из заголовка не проверен, поэтому память резервируется по мере поступления данных: вместимость
+    // растёт вдвое, но не больше total. Усечённый или повреждённый поток не вызывает огромного выделения памяти
+    void ReserveForRead(size_t count, uint64_t total) {
+        const size_t required = size_ + count;
+        if (required > data_.Capacity()) {
+            Reserve(static_cast<size_t>(std::min<uint64_t>(total, std::max(required, data_.Capacity() * 2))));
+        }
+    }
+
+    VectorStreamHeader MakeStreamHeader() const noexcept {
+        VectorStreamHeader header;
+        header.is_block = std::is_trivially_copyable_v<T> ? 1 : 0;
+        header.element_size = sizeof(T);
+        header.size = size_;
+        return header;
+    }
+
+    static void CheckStreamHeader(const VectorStreamHeader& header) {
+        if (header.magic != VectorStreamHeader::MAGIC || header.element_size != sizeof(T)
+            || header.is_block != (std::is_trivially_copyable_v<T> ? 1u : 0u)) {
+            throw std::runtime_error("Invalid Vector stream header");
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    static void WriteAll(int fd, const void* buf, size_t bytes) {
+        const char* ptr = static_cast<const char*>(buf);
+        while (bytes != 0) {
+            const ssize_t written = write(fd, ptr, bytes);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                throw std::runtime_error("Cannot write Vector");
+            }
+            ptr += written;
+            bytes -= static_cast<size_t>(written);
+        }
+    }
+
+    // Читает до bytes байт, повторяя чтение после частичных результатов; возвращает число прочитанных байт
+    static size_t ReadAll(int fd, void* buf, size_t bytes) {
+        char* ptr = static_cast<char*>(buf);
+        size_t total = 0;
+        while (total < bytes) {
+            const ssize_t received = read(fd, ptr + total, bytes - total);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received < 0) {
+                throw std::runtime_error("Cannot read Vector");
+            }
+            if (received == 0) {
+                break;
+            }
+            total += static_cast<size_t>(received);
+        }
+        return total;
+    }
+#endif
+
+    // Вместимость буфера, в который переносятся элементы при добавлении в заполненный вектор
+    size_t NextCapacity(size_t count = 1) const noexcept {
+        return GrowthPolicy::template NextCapacity<T>(data_.Capacity(), size_ + count);
+    }
+
+    // Позиция считается по непрерывному буферу: вызывающий метод уже завершил постепенный перенос
+    size_t CheckedShift(const_iterator pos) const {
+        assert(!IsMigrating());
+        if (pos < data_.GetAddress() || pos > data_ + size_) {
+            throw std::range_error("Pos value is outside the Vector");
+        }
+        return pos - data_.GetAddress();
+    }
+
+    // Вставляет count элементов в позицию shift. construct(buff_to, from, dist) создаёт в неинициализированной
+    // памяти элементы источника [from, from + dist), assign(buff_to, from, dist) присваивает их существующим элементам
+    template <typename Construct, typename Assign>
+    iterator InsertWith(size_t shift, size_t count, Construct construct, Assign assign) {
+        FinishMigration();
+        if (count == 0) {
+            return data_ + shift;
+        }
+        if (size_ + count > data_.Capacity()) {
+            RawMemory<T, Allocator> new_data(NextCapacity(count), GetAllocator());
+            construct(new_data + shift, 0, count);
+            if constexpr (IsTriviallyRelocatableV<T>) {
+                RelocateBytes(data_.GetAddress(), shift, new_data.GetAddress());
+                RelocateBytes(data_ + shift, size_ - shift, new_data + shift + count);
+            }
+            else {
+                // ------------------------------------------------------------
+                try {
+                    SelectUninitializedMoveOrCopy(data_.GetAddress(), shift, new_data.GetAddress());
+                }
+                catch (...) {
+                    std::destroy_n(new_data + shift, count);
+                    throw;
+                }
+                // ------------------------------------------------------------
+                try {
+                    SelectUninitializedMoveOrCopy(data_ + shift, size_ - shift, new_data + shift + count);
+                }
+                catch (...) {
+                    std::destroy_n(new_data.GetAddress(), shift + count);
+                    throw;
+                }
+                // ------------------------------------------------------------
+                std::destroy_n(data_.GetAddress(), size_);
+            }
+            ReplaceBuffer(new_data);
+            size_ += count;
+        }
+        else if constexpr (IsTriviallyRelocatableV<T>) {
+            ShiftBytes(data_ + shift, size_ - shift, data_ + shift + count);
+            try {
+                construct(data_ + shift, 0, count);
+            }
+            catch (...) {
+                ShiftBytes(data_ + shift + count, size_ - shift, data_ + shift);
+                throw;
+            }
+            size_ += count;
+        }
+        else {
+            size_t tail = size_ - shift;
+            T* old_end = data_ + size_;
+            VECTOR_COUNT(ELEMENTS_SHIFTED, tail);
+            if (tail > count) {
+                std::uninitialized_move(old_end - count, old_end, old_end);
+                size_ += count;
+                std::move_backward(data_ + shift, old_end - count, old_end);
+                assign(data_ + shift, 0, count);
+            }
+            else {
+                construct(old_end, tail, count - tail);
+                try {
+                    std::uninitialized_move(data_ + shift, old_end, data_ + shift + count);
+                }
+                catch (...) {
+                    std::destroy_n(old_end, count - tail);
+                    throw;
+                }
+                size_ += count;
+                assign(data_ + shift, 0, tail);
+            }
+        }
+        return data_ + shift;
+    }
+
     void SelectUninitializedMoveOrCopy(T* buff_from, size_t dist, T* buff_to) {
         if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
             std::uninitialized_move_n(buff_from, dist, buff_to);
+            VECTOR_COUNT(ELEMENTS_MOVED, dist);
         }
         else {
             std::uninitialized_copy_n(buff_from, dist, buff_to);
+            VECTOR_COUNT(ELEMENTS_COPIED, dist);
         }
     }
 
-    void SelectUninitializedMoveOrCopyWhole(RawMemory<T>& new_data) {
-        SelectUninitializedMoveOrCopy(data_.GetAddress(), size_, new_data.GetAddress());
-        std::destroy_n(data_.GetAddress(), size_);
+    void SelectUninitializedMoveOrCopyWhole(RawMemory<T, Allocator>& new_data) {
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            RelocateBytes(data_.GetAddress(), size_, new_data.GetAddress());
+        }
+        else {
+            SelectUninitializedMoveOrCopy(data_.GetAddress(), size_, new_data.GetAddress());
+            std::destroy_n(data_.GetAddress(), size_);
+        }
+    }
+
+    // Расширяет буфер средствами аллокатора (по возможности на месте) и вставляет новый элемент в позицию shift.
+    // Элемент создаётся до реаллокации, так как аргументы могут ссылаться на элементы вектора
+    template <typename... Args>
+    void GrowInPlaceAndInsert(size_t shift, Args&&... args) {
+        alignas(T) std::byte cp_value[sizeof(T)];
+        T* value = new (cp_value) T(std::forward<Args>(args)...);
+        try {
+            data_.Reallocate(NextCapacity());
+        }
+        catch (...) {
+            std::destroy_at(value);
+            throw;
+        }
+        ShiftBytes(data_ + shift, size_ - shift, data_ + shift + 1);
+        RelocateBytes(value, 1, data_ + shift);
+    }
+
+    // Добавление в конец в режиме IncrementalGrowth. При росте старый буфер сохраняется, а его элементы
+    // переносятся в новый порциями по migration_step_ при этом и последующих добавлениях
+    template <typename... Args>
+    T& EmplaceBackIncremental(Args&&... args) {
+        if (size_ == data_.Capacity()) {
+            // Шаг выбирается так, чтобы перенос завершился до следующего роста; завершение здесь — страховка
+            FinishMigration();
+            RawMemory<T, Allocator> new_data(NextCapacity(), GetAllocator());
+            // Элемент создаётся до переноса, так как аргументы могут ссылаться на элементы вектора
+            new (new_data + size_) T(std::forward<Args>(args)...);
+            ReplaceBuffer(new_data);
+            this->old_data_.Swap(new_data);
+            this->migrated_ = 0;
+            const size_t pushes_until_full = data_.Capacity() - size_;
+            this->migration_step_ = std::max(MIGRATION_STEP, (size_ + pushes_until_full - 1) / pushes_until_full);
+        }
+        else {
+            new (data_ + size_) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        T& result = *(data_ + size_ - 1);
+        if (IsMigrating()) {
+            Migrate(this->migration_step_);
+        }
+        return result;
+    }
+
+    // Переносит до count ещё не перенесённых элементов; освобождает старый буфер, когда перенос завершён
+    void Migrate([[maybe_unused]] size_t count) noexcept {
+        if constexpr (INCREMENTAL) {
+            const size_t old_size = this->old_data_.Capacity();
+            const size_t last = std::min(old_size, this->migrated_ + std::min(count, old_size));
+            T* buff_from = this->old_data_ + this->migrated_;
+            T* buff_to = data_ + this->migrated_;
+            if constexpr (IsTriviallyRelocatableV<T>) {
+                RelocateBytes(buff_from, last - this->migrated_, buff_to);
+            }
+            else {
+                std::uninitialized_move_n(buff_from, last - this->migrated_, buff_to);
+                VECTOR_COUNT(ELEMENTS_MOVED, last - this->migrated_);
+                std::destroy_n(buff_from, last - this->migrated_);
+            }
+            this->migrated_ = last;
+            if (last == old_size) {
+                RawMemory<T, Allocator> released(GetAllocator());
+                this->old_data_.Swap(released);
+                this->migrated_ = 0;
+            }
+        }
+    }
+
+    // Устанавливает новый буфер, оставляя прежний в new_data. Замена существующего буфера учитывается
+    // как REALLOCATIONS, первое выделение — нет
+    void ReplaceBuffer(RawMemory<T, Allocator>& new_data) noexcept {
+        if (data_.Capacity() != 0) {
+            VECTOR_COUNT(REALLOCATIONS, 1);
+        }
+        data_.Swap(new_data);
+    }
+
+    // Копирует count элементов в неинициализированную память; тривиально копируемые — целиком через CopyBytes
+    static void UninitializedCopy(const T* buff_from, size_t count, T* buff_to, StreamingHint hint) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            CopyBytes(buff_to, buff_from, count * sizeof(T), hint);
+        }
+        else {
+            std::uninitialized_copy_n(buff_from, count, buff_to);
+        }
+    }
+
+    // Переносит dist элементов в неинициализированную неперекрывающуюся память без вызова конструкторов и деструкторов
+    static void RelocateBytes(T* buff_from, size_t dist, T* buff_to) noexcept {
+        VECTOR_COUNT(ELEMENTS_RELOCATED, dist);
+        if (dist != 0) {
+            std::memcpy(static_cast<void*>(buff_to), static_cast<const void*>(buff_from), dist * sizeof(T));
+        }
+    }
+
+    // Сдвигает dist элементов внутри одного буфера, области могут перекрываться
+    static void ShiftBytes(T* buff_from, size_t dist, T* buff_to) noexcept {
+        VECTOR_COUNT(ELEMENTS_SHIFTED, dist);
+        if (dist != 0) {
+            std::memmove(static_cast<void*>(buff_to), static_cast<const void*>(buff_from), dist * sizeof(T));
+        }
     }
 
 private:
-    RawMemory<T> data_;
+    RawMemory<T, Allocator> data_;
     size_t size_ = 0;
 };
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename Predicate>
+size_t EraseIf(Vector<T, Allocator, GrowthPolicy>& vector, Predicate pred) {
+    return vector.EraseIf(pred);
+}